@@ -41,6 +41,7 @@
 //#include <sys/stat.h>
 //#include <fcntl.h>
 #include <stdint.h>
+#include <stdlib.h>
 
 #include "doomdef.h"
 #include "doomtype.h"
@@ -72,6 +73,7 @@
 #include "lprintf.h"  // jff 08/03/98 - declaration of lprintf
 #include "am_map.h"
 #include "m_cheat.h"
+#include "r_profile.h"
 
 #include "doom_iwad.h"
 #include "global_data.h"
@@ -100,6 +102,12 @@ const boolean nodrawers = false;
 
 static const char* timedemo = NULL;//"demo1";
 
+// Set TIMEDEMO to 1 to play all the demos of the demo loop back to back, one tic per frame
+// and without the title pages in between, and quit after the last one. Ports time the frames.
+#ifndef TIMEDEMO
+#define TIMEDEMO 0
+#endif
+
 /*
  * D_PostEvent - Event handling
  *
@@ -231,9 +239,13 @@ static void D_Display (void)
         if (_g->automapmode & am_active)
             AM_Drawer();
 
+        RP_BEGIN(RP_STATUSBAR);
         ST_Drawer(true, false);
+        RP_END();
 
+        RP_BEGIN(RP_HUD);
         HU_Drawer();
+        RP_END();
     }
 
     _g->oldgamestate = _g->wipegamestate = _g->gamestate;
@@ -245,7 +257,11 @@ static void D_Display (void)
 
     // normal update
     if (!wipe)
+    {
+        RP_BEGIN(RP_BLIT);
         I_FinishUpdate ();              // page flip or blit buffer
+        RP_END();
+    }
     else
     {
         // wipe update
@@ -254,6 +270,12 @@ static void D_Display (void)
     }
 
     I_EndDisplay();
+
+    // Let the cache load what the renderer asked for ahead of the next frame
+    NC_ServicePrefetch();
+    NC_IdleDefrag();
+    NC_EndFrame();
+    RP_ENDFRAME();
 }
 
 //
@@ -469,8 +491,17 @@ void D_DoAdvanceDemo(void)
     _g->gamestate = GS_DEMOSCREEN;
 
 
+    #if TIMEDEMO == 1
+    // Only the demos are timed, and they are only played once
+    while (demostates[++_g->demosequence][_g->gamemode].func != G_DeferedPlayDemo)
+    {
+        if (!demostates[_g->demosequence][_g->gamemode].func)
+            exit(0);
+    }
+    #else
     if (!demostates[++_g->demosequence][_g->gamemode].func)
         _g->demosequence = 0;
+    #endif
 
     demostates[_g->demosequence][_g->gamemode].func(demostates[_g->demosequence][_g->gamemode].name);
 }
@@ -754,6 +785,10 @@ static void D_DoomMainSetup(void)
     }
     else
     {
+        #if TIMEDEMO == 1
+        _g->singletics = true;
+        _g->timingdemo = true;
+        #endif
         D_StartTitle();                 // start up intro loop
     }
 }
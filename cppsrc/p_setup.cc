@@ -455,7 +455,7 @@ void P_FreeLevelData()
     R_ResetPlanes();
 
     Z_FreeTags(PU_LEVEL, PU_PURGELEVEL-1);
-    NC_FlushCache();
+    NC_EndLevel();
 
     //Z_Free(_g->braintargets);
     _g->braintargets = NULL;
@@ -512,6 +512,9 @@ void P_SetupLevel(int episode, int map, int playermask UNUSED, skill_t skill UNU
 
     lumpnum = NC_GetNumForName(lumpname);
 
+    // Warm the cache with what this map used the last time it was played
+    NC_BeginLevel(lumpnum);
+
     _g->leveltime = 0; _g->totallive = 0;
 
     P_LoadVertexes  (lumpnum+ML_VERTEXES);
@@ -189,6 +189,7 @@ void P_Ticker (void)
     return;
 
   P_MapStart();
+  NC_BeginEpoch();
                // not if this is an intermission screen
   if(_g->gamestate==GS_LEVEL)
     if (_g->playeringame)
@@ -197,7 +198,9 @@ void P_Ticker (void)
   P_RunThinkers();
   P_UpdateSpecials();
   P_RespawnSpecials();
+  NC_EndEpoch();
   P_MapEnd();
   _g->leveltime++;                       // for par times
+  NC_LevelTic();
 }
 
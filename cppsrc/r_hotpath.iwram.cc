@@ -66,10 +66,20 @@
 #include "global_data.h"
 
 #include "gba_functions.h"
+#include "r_profile.h"
+#include "r_threads.h"
+#include "r_simd.h"
 
 #include <assert.h>
 #include <stdlib.h>
 
+// Set RENDER_SORTED to 1 to draw the walls and flats of a frame grouped by texture, so that
+// each one is looked up and pinned once rather than once per column or span. The wall columns
+// are queued until the BSP traversal is done, which takes WALLQUEUE_SIZE entries of memory.
+#ifndef RENDER_SORTED
+#define RENDER_SORTED 0
+#endif
+
 
 //#define static
 
@@ -552,26 +562,136 @@ inline static void R_DrawColumnPixel(unsigned short* dest, const uint8_t* source
 #endif
 }
 
-static void R_DrawColumn (const draw_column_vars_t *dcvars)
+#if RENDER_THREADS > 0
+//
+// Draw queue for the render threads (see r_threads.h). Columns and spans are queued with what
+// their inner loop needs, and the texels they read are copied, so nothing in the cache has to
+// stay put until they are drawn: columns to the queue bytes, and colormaps and flats once, as
+// lumps never change. Each thread draws all of the queue that falls in its strip, in order,
+// so every pixel is drawn the same way and in the same order as when drawn right away.
+//
+
+#include <string.h>
+
+#ifndef DRAWQUEUE_SIZE
+#define DRAWQUEUE_SIZE 8192
+#endif
+
+#ifndef DRAWQUEUE_BYTES
+#define DRAWQUEUE_BYTES (DRAWQUEUE_SIZE*64)
+#endif
+
+enum { QD_COLUMN, QD_COLUMNHIRES, QD_FUZZCOLUMN, QD_SPAN };
+
+typedef struct {
+    uint8_t kind;
+    uint8_t param;              // odd_pixel for QD_COLUMNHIRES, fuzzpos for QD_FUZZCOLUMN
+    short x;                    // Screen column, the first one for spans
+    short count;                // Pixels to draw
+    unsigned short* dest;
+    const uint8_t* source;
+    const uint8_t* colormap;
+    unsigned int frac;          // position for spans
+    unsigned int step;
+} queued_draw_t;
+
+static queued_draw_t drawqueue[DRAWQUEUE_SIZE];
+static int drawqueued = 0;
+static uint8_t drawqueuebytes[DRAWQUEUE_BYTES];
+static int drawqueuebytesused = 0;
+
+static uint8_t* colormapcopy = nullptr;
+static uint8_t* flatcopies[MAXLUMPS];
+static int drawflat = -1;   // Lump of the flat R_DoDrawPlane() is drawing
+
+static void R_FlushDrawQueue(void);
+
+// Next entry in the queue, with room for bytes of texels after the ones queued
+static queued_draw_t* R_QueueDraw(int kind, int x, int count, unsigned short* dest, int bytes)
 {
-    int count = (dcvars->yh - dcvars->yl) + 1;
+    if (drawqueued == DRAWQUEUE_SIZE || drawqueuebytesused + bytes > DRAWQUEUE_BYTES)
+        R_FlushDrawQueue();
 
-    // Zero length, column does not exceed a pixel.
-    if (count <= 0)
-        return;
+    queued_draw_t* qd = &drawqueue[drawqueued++];
+    qd->kind = kind;
+    qd->x = x;
+    qd->count = count;
+    qd->dest = dest;
+    return qd;
+}
 
-    auto pin = dcvars->sourcecache.pin();
-    
-    const uint8_t *source = (pin.isnull()) ? dcvars->source : (const uint8_t*)pin;
-    assert(source!=NULL);
-    auto pinnedcolormap = dcvars->colormap.pin();
-    const uint8_t *colormap = pinnedcolormap;
+// All colormaps are in the COLORMAP lump, so one copy of it does for all of them
+static const uint8_t* R_CopyColormap(const uint8_t* colormap, unsigned int byteoffset)
+{
+    if (!colormapcopy)
+    {
+        const int len = colormaps.size() * sizeof(lighttable_t);
+        colormapcopy = (uint8_t*)malloc(len);
+        memcpy(colormapcopy, colormap - byteoffset, len);
+    }
 
-    unsigned short* dest = drawvars.byte_topleft + ScreenYToOffset(dcvars->yl) + dcvars->x;
+    return colormapcopy + byteoffset;
+}
 
-    const unsigned int		fracstep = (dcvars->iscale << COLEXTRABITS);
-    unsigned int frac = (dcvars->texturemid + (dcvars->yl - centery)*dcvars->iscale) << COLEXTRABITS;
+// Queue a column, copying the texels it reads to the same offsets from the copy
+static void R_QueueColumn(int kind, const draw_column_vars_t *dcvars, unsigned short* dest, const uint8_t* source, const uint8_t* colormap, unsigned int frac, const unsigned int fracstep, int count)
+{
+    const uint64_t last = (uint64_t)frac + (uint64_t)fracstep*(count-1);
+    const unsigned int first = frac >> COLBITS;
+    const unsigned int end = (last > UINT_MAX) ? (1 << (32 - COLBITS)) : (unsigned int)(last >> COLBITS) + 1;
 
+    queued_draw_t* qd = R_QueueDraw(kind, dcvars->x, count, dest, end);
+    uint8_t* copy = &drawqueuebytes[drawqueuebytesused];
+    drawqueuebytesused += end;
+
+    if (last <= UINT_MAX)
+        memcpy(copy + first, source + first, end - first);
+    else
+    {
+        // frac wraps around - only copy what is read
+        unsigned int f = frac;
+        for (int i = 0; i < count; i++, f += fracstep)
+            copy[f >> COLBITS] = source[f >> COLBITS];
+    }
+
+    qd->param = dcvars->odd_pixel;
+    qd->source = copy;
+    qd->colormap = R_CopyColormap(colormap, dcvars->colormap.byteoffset());
+    qd->frac = frac;
+    qd->step = fracstep;
+}
+
+// Queue a fuzz column and move fuzzpos on as drawing it would
+static void R_QueueFuzzColumn(int x, unsigned short* dest, const uint8_t* colormap, unsigned int byteoffset, int count)
+{
+    queued_draw_t* qd = R_QueueDraw(QD_FUZZCOLUMN, x, count, dest, 0);
+    qd->param = _g->fuzzpos;
+    qd->colormap = R_CopyColormap(colormap, byteoffset);
+
+    _g->fuzzpos = (_g->fuzzpos + count) % 50;
+}
+
+static void R_QueueSpan(int x, unsigned short* dest, const uint8_t* source, const uint8_t* colormap, const draw_span_vars_t *dsvars, int count)
+{
+    if (!flatcopies[drawflat])
+    {
+        flatcopies[drawflat] = (uint8_t*)malloc(64*64);
+        memcpy(flatcopies[drawflat], source, 64*64);
+    }
+
+    queued_draw_t* qd = R_QueueDraw(QD_SPAN, x, count, dest, 0);
+    qd->source = flatcopies[drawflat];
+    qd->colormap = R_CopyColormap(colormap, dsvars->colormap.byteoffset());
+    qd->frac = dsvars->position;
+    qd->step = dsvars->step;
+}
+#endif
+
+static inline void R_RasterColumn(unsigned short* dest, const uint8_t* source, const uint8_t* colormap, unsigned int frac, const unsigned int fracstep, int count)
+{
+#if RENDER_SIMD == 1
+    RS_DrawColumn(dest, source, colormap, frac, fracstep, count);
+#else
     // Inner loop that does the actual texture mapping,
     //  e.g. a DDA-lile scaling.
     // This is as fast as it gets.
@@ -621,28 +741,40 @@ static void R_DrawColumn (const draw_column_vars_t *dcvars)
         case 2:     R_DrawColumnPixel(dest, source, colormap, frac); dest+=SCREENWIDTH; frac+=fracstep;
         case 1:     R_DrawColumnPixel(dest, source, colormap, frac);
     }
+#endif
 }
 
-static void R_DrawColumnHiRes(const draw_column_vars_t *dcvars)
+static void R_DrawColumn (const draw_column_vars_t *dcvars)
 {
     int count = (dcvars->yh - dcvars->yl) + 1;
 
     // Zero length, column does not exceed a pixel.
     if (count <= 0)
         return;
-    
-    auto pin = dcvars->sourcecache.pin();
 
+    RP_COLUMN();
+
+    auto pin = dcvars->sourcecache.pin();
+    
     const uint8_t *source = (pin.isnull()) ? dcvars->source : (const uint8_t*)pin;
     assert(source!=NULL);
     auto pinnedcolormap = dcvars->colormap.pin();
     const uint8_t *colormap = pinnedcolormap;
 
-    volatile unsigned short* dest = drawvars.byte_topleft + ScreenYToOffset(dcvars->yl) + dcvars->x;
+    unsigned short* dest = drawvars.byte_topleft + ScreenYToOffset(dcvars->yl) + dcvars->x;
 
     const unsigned int		fracstep = (dcvars->iscale << COLEXTRABITS);
     unsigned int frac = (dcvars->texturemid + (dcvars->yl - centery)*dcvars->iscale) << COLEXTRABITS;
 
+#if RENDER_THREADS > 0
+    R_QueueColumn(QD_COLUMN, dcvars, dest, source, colormap, frac, fracstep, count);
+#else
+    R_RasterColumn(dest, source, colormap, frac, fracstep, count);
+#endif
+}
+
+static inline void R_RasterColumnHiRes(volatile unsigned short* dest, const uint8_t* source, const uint8_t* colormap, unsigned int frac, const unsigned int fracstep, int count, boolean odd_pixel)
+{
     // Inner loop that does the actual texture mapping,
     //  e.g. a DDA-lile scaling.
     // This is as fast as it gets.
@@ -650,7 +782,7 @@ static void R_DrawColumnHiRes(const draw_column_vars_t *dcvars)
     unsigned int mask;
     unsigned int shift;
 
-    if(!dcvars->odd_pixel)
+    if(!odd_pixel)
     {
         mask = 0xff00;
         shift = 0;
@@ -673,6 +805,35 @@ static void R_DrawColumnHiRes(const draw_column_vars_t *dcvars)
     }
 }
 
+static void R_DrawColumnHiRes(const draw_column_vars_t *dcvars)
+{
+    int count = (dcvars->yh - dcvars->yl) + 1;
+
+    // Zero length, column does not exceed a pixel.
+    if (count <= 0)
+        return;
+
+    RP_COLUMN();
+    
+    auto pin = dcvars->sourcecache.pin();
+
+    const uint8_t *source = (pin.isnull()) ? dcvars->source : (const uint8_t*)pin;
+    assert(source!=NULL);
+    auto pinnedcolormap = dcvars->colormap.pin();
+    const uint8_t *colormap = pinnedcolormap;
+
+    volatile unsigned short* dest = drawvars.byte_topleft + ScreenYToOffset(dcvars->yl) + dcvars->x;
+
+    const unsigned int		fracstep = (dcvars->iscale << COLEXTRABITS);
+    unsigned int frac = (dcvars->texturemid + (dcvars->yl - centery)*dcvars->iscale) << COLEXTRABITS;
+
+#if RENDER_THREADS > 0
+    R_QueueColumn(QD_COLUMNHIRES, dcvars, (unsigned short*)dest, source, colormap, frac, fracstep, count);
+#else
+    R_RasterColumnHiRes(dest, source, colormap, frac, fracstep, count, dcvars->odd_pixel);
+#endif
+}
+
 #define FUZZOFF (SCREENWIDTH)
 #define FUZZTABLE 50
 
@@ -687,6 +848,20 @@ static const int fuzzoffset[FUZZTABLE] =
     FUZZOFF,FUZZOFF,-FUZZOFF,FUZZOFF,FUZZOFF,-FUZZOFF,FUZZOFF
 };
 
+static inline unsigned int R_RasterFuzzColumn(unsigned short* dest, const uint8_t* colormap, unsigned int fuzzpos, int count)
+{
+    do
+    {        
+        R_DrawColumnPixel(dest, (const uint8_t*)&dest[fuzzoffset[fuzzpos]], colormap, 0); dest += SCREENWIDTH;  fuzzpos++;
+
+        if(fuzzpos >= 50)
+            fuzzpos = 0;
+
+    } while(--count);
+
+    return fuzzpos;
+}
+
 //
 // Framebuffer postprocessing.
 // Creates a fuzzy image by copying pixels
@@ -714,23 +889,18 @@ static void R_DrawFuzzColumn (const draw_column_vars_t *dcvars)
     if (count <= 0)
         return;
 
+    RP_COLUMN();
+
     auto pinnedcolormap = fullcolormap.addOffset(6*256).pin();
     const uint8_t* colormap = pinnedcolormap; //&fullcolormap[6*256];
 
     unsigned short* dest = drawvars.byte_topleft + ScreenYToOffset(dc_yl) + dcvars->x;
 
-    unsigned int fuzzpos = _g->fuzzpos;
-
-    do
-    {        
-        R_DrawColumnPixel(dest, (const uint8_t*)&dest[fuzzoffset[fuzzpos]], colormap, 0); dest += SCREENWIDTH;  fuzzpos++;
-
-        if(fuzzpos >= 50)
-            fuzzpos = 0;
-
-    } while(--count);
-
-    _g->fuzzpos = fuzzpos;
+#if RENDER_THREADS > 0
+    R_QueueFuzzColumn(dcvars->x, dest, colormap, fullcolormap.byteoffset() + 6*256, count);
+#else
+    _g->fuzzpos = R_RasterFuzzColumn(dest, colormap, _g->fuzzpos, count);
+#endif
 }
 
 
@@ -963,6 +1133,24 @@ static Cached<column_t> R_GetColumn(const texture_t* texture, int texcolumn)
 }
 
 
+// Draw a column of a single patch texture. Wall and sky patches can be large, so only the part
+// of the patch that covers the column is pinned - the cache then only reads the pages it needs.
+static void R_DrawPatchTextureColumn(const texture_t* tex, int texcolumn, draw_column_vars_t* dcvars)
+{
+    auto patch = tex->patches[0].patch;
+    const int xc = texcolumn & tex->widthmask;
+
+    const int columnofs = *patch.transmuteToObjectAtByteOffset<int>(offsetof(patch_t,columnofs) + xc*sizeof(int)).pinRange(sizeof(int));
+
+    // Post header and as many pixels as R_DrawColumn can reach before frac wraps around
+    auto column = patch.transmuteToObjectAtByteOffset<uint8_t>(columnofs).pinRange(3 + (1 << (32 - COLBITS)));
+
+    dcvars->sourcecache = CachedBuffer<uint8_t>();
+    dcvars->source = (const uint8_t*)column + 3;
+
+    R_DrawColumn (dcvars);
+}
+
 static const texture_t* R_GetOrLoadTexture(int tex_num)
 {
     const texture_t* tex = textures[tex_num];
@@ -1257,6 +1445,7 @@ static void R_DrawPSprite (pspdef_t *psp, int lightlevel)
 
 static void R_DrawPlayerSprites(void)
 {
+  RP_SCOPE(RP_PSPRITES);
 
   int i, lightlevel = _g->player.mo->subsector->sector->lightlevel;
   pspdef_t *psp;
@@ -1305,6 +1494,7 @@ static void R_SortVisSprites (void)
 
 static void R_DrawMasked(void)
 {
+    RP_SCOPE(RP_MASKED);
     int i;
     drawseg_t *ds;
     drawseg_t* drawsegs = _g->drawsegs;
@@ -1356,20 +1546,15 @@ inline static void R_DrawSpanPixel(unsigned short* dest, const uint8_t* source,
 #endif
 }
 
-static void R_DrawSpan(unsigned int y, unsigned int x1, unsigned int x2, const draw_span_vars_t *dsvars)
-{
-    unsigned int count = (x2 - x1);
-
-    auto pinnedsource = dsvars->source.pin();
-    const uint8_t *source = pinnedsource;
-    auto pinnedcolormap = dsvars->colormap.pin();
-    const uint8_t *colormap = pinnedcolormap;
-
-    unsigned short* dest = drawvars.byte_topleft + ScreenYToOffset(y) + x1;
-
-    const unsigned int step = dsvars->step;
-    unsigned int position = dsvars->position;
+#if RENDER_SORTED == 1
+static const uint8_t* planeflat = nullptr;  // Flat of the planes being drawn, pinned by R_DrawPlanes()
+#endif
 
+static inline void R_RasterSpan(unsigned short* dest, const uint8_t* source, const uint8_t* colormap, unsigned int position, const unsigned int step, unsigned int count)
+{
+#if RENDER_SIMD == 1
+    RS_DrawSpan(dest, source, colormap, position, step, count);
+#else
     unsigned int l = (count >> 4);
 
     while(l--)
@@ -1415,8 +1600,82 @@ static void R_DrawSpan(unsigned int y, unsigned int x1, unsigned int x2, const d
         case 2:     R_DrawSpanPixel(dest, source, colormap, position); dest++; position+=step;
         case 1:     R_DrawSpanPixel(dest, source, colormap, position);
     }
+#endif
+}
+
+
+static void R_DrawSpan(unsigned int y, unsigned int x1, unsigned int x2, const draw_span_vars_t *dsvars)
+{
+    unsigned int count = (x2 - x1);
+
+    RP_SPAN();
+
+#if RENDER_SORTED == 1
+    const uint8_t *source = planeflat;
+#else
+    auto pinnedsource = dsvars->source.pin();
+    const uint8_t *source = pinnedsource;
+#endif
+    auto pinnedcolormap = dsvars->colormap.pin();
+    const uint8_t *colormap = pinnedcolormap;
+
+    unsigned short* dest = drawvars.byte_topleft + ScreenYToOffset(y) + x1;
+
+#if RENDER_THREADS > 0
+    R_QueueSpan(x1, dest, source, colormap, dsvars, count);
+#else
+    R_RasterSpan(dest, source, colormap, dsvars->position, dsvars->step, count);
+#endif
+}
+
+#if RENDER_THREADS > 0
+// Draw the part of the queue that falls in the screen columns [x1,x2)
+static void R_DrawQueueStrip(int x1, int x2)
+{
+    for (int i = 0; i < drawqueued; i++)
+    {
+        const queued_draw_t* qd = &drawqueue[i];
+
+        if (qd->kind == QD_SPAN)
+        {
+            const int first = qd->x > x1 ? qd->x : x1;
+            const int end = qd->x + qd->count < x2 ? qd->x + qd->count : x2;
+
+            if (first < end)
+            {
+                const unsigned int skip = first - qd->x;
+                R_RasterSpan(qd->dest + skip, qd->source, qd->colormap, qd->frac + skip*qd->step, qd->step, end - first);
+            }
+            continue;
+        }
+
+        if (qd->x < x1 || qd->x >= x2)
+            continue;
+
+        switch (qd->kind)
+        {
+            case QD_COLUMN:
+                R_RasterColumn(qd->dest, qd->source, qd->colormap, qd->frac, qd->step, qd->count);
+                break;
+            case QD_COLUMNHIRES:
+                R_RasterColumnHiRes(qd->dest, qd->source, qd->colormap, qd->frac, qd->step, qd->count, qd->param);
+                break;
+            case QD_FUZZCOLUMN:
+                R_RasterFuzzColumn(qd->dest, qd->colormap, qd->param, qd->count);
+                break;
+        }
+    }
 }
 
+static void R_FlushDrawQueue(void)
+{
+    if (drawqueued)
+        RT_Run(R_DrawQueueStrip);
+
+    drawqueued = 0;
+    drawqueuebytesused = 0;
+}
+#endif
 
 static void R_MapPlane(unsigned int y, unsigned int x1, unsigned int x2, draw_span_vars_t *dsvars)
 {    
@@ -1493,6 +1752,12 @@ static void R_DoDrawPlane(visplane_t *pl)
                 {
                     int xc = ((viewangle + xtoviewangle[x]) >> ANGLETOSKYSHIFT);
 
+                    if (tex->patchcount == 1)
+                    {
+                        R_DrawPatchTextureColumn(tex, xc, &dcvars);
+                        continue;
+                    }
+
                     auto column = R_GetColumn(tex, xc);
                     auto columnptr = column.bytebuffer();
                     columnptr += 3;
@@ -1509,6 +1774,9 @@ static void R_DoDrawPlane(visplane_t *pl)
             draw_span_vars_t dsvars;
 
             dsvars.source = CachedBuffer<uint8_t>(_g->firstflat + flattranslation[pl->picnum]);
+#if RENDER_THREADS > 0
+            drawflat = _g->firstflat + flattranslation[pl->picnum];
+#endif
             dsvars.colormap = R_LoadColorMap(pl->lightlevel);
 
             planeheight = D_abs(pl->height-viewz);
@@ -1989,6 +2257,12 @@ static void R_DrawSegTextureColumn(unsigned int texture, int texcolumn, draw_col
 {
     const texture_t* tex = R_GetOrLoadTexture(texture);
 
+    if(tex->overlapped == 0 && tex->patchcount == 1)
+    {
+        R_DrawPatchTextureColumn(tex, texcolumn, dcvars);
+        return;
+    }
+
     if(tex->overlapped == 0)
     {
         auto column = R_GetColumn(tex, texcolumn);
@@ -2009,6 +2283,118 @@ static void R_DrawSegTextureColumn(unsigned int texture, int texcolumn, draw_col
     R_DrawColumn (dcvars);
 }
 
+#if RENDER_SORTED == 1
+//
+// Wall columns are queued by R_RenderSegLoop() and drawn by R_DrawWalls() sorted by texture
+// and column, so each texture is looked up once and a single patch pinned once, and the column
+// cache sees the columns of a texture together. Walls don't overlap, so the order doesn't show.
+//
+
+#ifndef WALLQUEUE_SIZE
+#define WALLQUEUE_SIZE 512
+#endif
+
+typedef struct {
+    CachedBuffer<lighttable_t> colormap;
+    fixed_t iscale;
+    fixed_t texturemid;
+    int texcolumn;
+    unsigned short texture;
+    uint8_t x;
+    uint8_t yl;
+    uint8_t yh;
+} queued_wall_t;
+
+static queued_wall_t wallqueue[WALLQUEUE_SIZE];
+static int wallsqueued = 0;
+
+static int R_CompareWalls(const void* l, const void* r)
+{
+    const queued_wall_t* wl = (const queued_wall_t*)l;
+    const queued_wall_t* wr = (const queued_wall_t*)r;
+
+    if (wl->texture != wr->texture)
+        return wl->texture - wr->texture;
+    if (wl->texcolumn != wr->texcolumn)
+        return wl->texcolumn < wr->texcolumn ? -1 : 1;
+    if (wl->x != wr->x)
+        return wl->x - wr->x;
+
+    return wl->yl - wr->yl;
+}
+
+static void R_DrawWalls(void)
+{
+    RP_SCOPE(RP_SEGS);
+    draw_column_vars_t dcvars;
+
+    R_SetDefaultDrawColumnVars(&dcvars);
+
+    qsort(wallqueue, wallsqueued, sizeof(queued_wall_t), R_CompareWalls);
+
+    for (int i = 0; i < wallsqueued; )
+    {
+        const unsigned int texture = wallqueue[i].texture;
+        const texture_t* tex = R_GetOrLoadTexture(texture);
+
+        int end = i;
+        while (end < wallsqueued && wallqueue[end].texture == texture)
+            end++;
+
+        // Simple textures are drawn straight from the patch, pinned once for all of the columns
+        auto patch = (tex->overlapped == 0 && tex->patchcount == 1) ? tex->patches[0].patch : Cached<patch_t>();
+        auto pinnedpatch = patch.pin();
+        const patch_t* patchptr = pinnedpatch.isnull() ? nullptr : (const patch_t*)pinnedpatch;
+
+        for (; i < end; i++)
+        {
+            const queued_wall_t* wall = &wallqueue[i];
+
+            dcvars.x = wall->x;
+            dcvars.yl = wall->yl;
+            dcvars.yh = wall->yh;
+            dcvars.iscale = wall->iscale;
+            dcvars.texturemid = wall->texturemid;
+            dcvars.colormap = wall->colormap;
+
+            if (patchptr)
+            {
+                dcvars.sourcecache = CachedBuffer<uint8_t>();
+                dcvars.source = (const uint8_t*)patchptr + patchptr->columnofs[wall->texcolumn & tex->widthmask] + 3;
+                R_DrawColumn(&dcvars);
+            }
+            else
+                R_DrawSegTextureColumn(texture, wall->texcolumn, &dcvars);
+        }
+    }
+
+    wallsqueued = 0;
+}
+#endif
+
+static void R_DrawWallColumn(unsigned int texture, int texcolumn, draw_column_vars_t* dcvars)
+{
+#if RENDER_SORTED == 1
+    if (dcvars->yl > dcvars->yh)
+        return;
+
+    if (wallsqueued == WALLQUEUE_SIZE)
+        R_DrawWalls();
+
+    queued_wall_t* wall = &wallqueue[wallsqueued++];
+    wall->colormap = dcvars->colormap;
+    wall->iscale = dcvars->iscale;
+    wall->texturemid = dcvars->texturemid;
+    wall->texcolumn = texcolumn;
+    wall->texture = texture;
+    wall->x = dcvars->x;
+    wall->yl = dcvars->yl;
+    wall->yh = dcvars->yh;
+#else
+    R_DrawSegTextureColumn(texture, texcolumn, dcvars);
+#endif
+}
+
 //
 // R_RenderSegLoop
 // Draws zero, one, or two textures (and possibly a masked texture) for walls.
@@ -2021,6 +2407,7 @@ static void R_DrawSegTextureColumn(unsigned int texture, int texcolumn, draw_col
 
 static void R_RenderSegLoop (int rw_x)
 {
+    RP_SCOPE(RP_SEGS);
     draw_column_vars_t dcvars;
     fixed_t  texturecolumn = 0;   // shut up compiler warning
 
@@ -2104,7 +2491,7 @@ static void R_RenderSegLoop (int rw_x)
             dcvars.texturemid = rw_midtexturemid;
             //
 
-            R_DrawSegTextureColumn(midtexture, texturecolumn, &dcvars);
+            R_DrawWallColumn(midtexture, texturecolumn, &dcvars);
 
             cc_rwx = viewheight;
             fc_rwx = -1;
@@ -2128,7 +2515,7 @@ static void R_RenderSegLoop (int rw_x)
                     dcvars.yh = mid;
                     dcvars.texturemid = rw_toptexturemid;
 
-                    R_DrawSegTextureColumn(toptexture, texturecolumn, &dcvars);
+                    R_DrawWallColumn(toptexture, texturecolumn, &dcvars);
 
                     cc_rwx = mid;
                 }
@@ -2157,7 +2544,7 @@ static void R_RenderSegLoop (int rw_x)
                     dcvars.yh = yh;
                     dcvars.texturemid = rw_bottomtexturemid;
 
-                    R_DrawSegTextureColumn(bottomtexture, texturecolumn, &dcvars);
+                    R_DrawWallColumn(bottomtexture, texturecolumn, &dcvars);
 
                     fc_rwx = mid;
                 }
@@ -2713,6 +3100,18 @@ static void R_AddLine (Cached<seg_t> line)
 //
 // killough 1/31/98 -- made static, polished
 
+//
+// R_PrefetchFlat
+// Flats are only needed once the planes are drawn after the BSP walk,
+// so queue them now and let the cache load them in the meantime.
+//
+
+static void R_PrefetchFlat(int picnum)
+{
+    if (picnum != _g->skyflatnum)
+        NC_Prefetch(_g->firstflat + flattranslation[picnum]);
+}
+
 static void R_Subsector(int num)
 {
     int         count;
@@ -2730,6 +3129,7 @@ static void R_Subsector(int num)
                                      frontsector->floorpic,
                                      frontsector->lightlevel                // killough 3/16/98
                                      );
+        R_PrefetchFlat(frontsector->floorpic);
     }
     else
     {
@@ -2743,6 +3143,7 @@ static void R_Subsector(int num)
                                        frontsector->ceilingpic,
                                        frontsector->lightlevel
                                        );
+        R_PrefetchFlat(frontsector->ceilingpic);
     }
     else
     {
@@ -2959,8 +3360,71 @@ static void R_ClearSprites(void)
 // At the end of each frame.
 //
 
+#if RENDER_SORTED == 1
+//
+// The modified visplanes of a frame are gathered by R_DrawPlanes() and drawn sorted by flat,
+// so each flat is pinned once for all of its planes. Planes don't overlap, so the order
+// doesn't show.
+//
+
+#ifndef PLANEQUEUE_SIZE
+#define PLANEQUEUE_SIZE 128
+#endif
+
+static visplane_t* planequeue[PLANEQUEUE_SIZE];
+static int planesqueued = 0;
+
+static int R_ComparePlanes(const void* l, const void* r)
+{
+    const visplane_t* pl = *(visplane_t* const*)l;
+    const visplane_t* pr = *(visplane_t* const*)r;
+
+    return pl->picnum - pr->picnum;
+}
+
+static void R_DrawPlaneQueue(void)
+{
+    qsort(planequeue, planesqueued, sizeof(visplane_t*), R_ComparePlanes);
+
+    for (int i = 0; i < planesqueued; )
+    {
+        const int picnum = planequeue[i]->picnum;
+        auto flat = (picnum == _g->skyflatnum) ? CachedBuffer<uint8_t>() : CachedBuffer<uint8_t>(_g->firstflat + flattranslation[picnum]);
+        auto pinnedflat = flat.pin();
+        planeflat = pinnedflat;
+
+        for (; i < planesqueued && planequeue[i]->picnum == picnum; i++)
+        {
+            R_DoDrawPlane(planequeue[i]);
+            RP_COUNT(visplanes,1);
+        }
+    }
+
+    planeflat = nullptr;
+    planesqueued = 0;
+}
+#endif
+
 static void R_DrawPlanes (void)
 {
+    RP_SCOPE(RP_PLANES);
+#if RENDER_SORTED == 1
+    for (int i=0; i<MAXVISPLANES; i++)
+    {
+        for (visplane_t *pl = _g->visplanes[i]; pl; pl = pl->next)
+        {
+            if(!pl->modified)
+                continue;
+
+            if (planesqueued == PLANEQUEUE_SIZE)
+                R_DrawPlaneQueue();
+
+            planequeue[planesqueued++] = pl;
+        }
+    }
+
+    R_DrawPlaneQueue();
+#else
     for (int i=0; i<MAXVISPLANES; i++)
     {
         visplane_t *pl = _g->visplanes[i];
@@ -2968,11 +3432,15 @@ static void R_DrawPlanes (void)
         while(pl)
         {
             if(pl->modified)
+            {
                 R_DoDrawPlane(pl);
+                RP_COUNT(visplanes,1);
+            }
 
             pl = pl->next;
         }
     }
+#endif
 }
 
 //
@@ -3004,6 +3472,9 @@ static void R_ClearPlanes(void)
 //
 void R_RenderPlayerView (player_t* player)
 {
+    // Map data and graphics stay put for the whole frame
+    NC_BeginEpoch();
+
     R_SetupFrame (player);
 
     // Clear buffers.
@@ -3013,11 +3484,25 @@ void R_RenderPlayerView (player_t* player)
     R_ClearSprites ();
 
     // The head node is the last node output.
+    RP_BEGIN(RP_BSP);
     R_RenderBSPNode (numnodes-1);
+    RP_END();
+    RP_COUNT(drawsegs,ds_p - _g->drawsegs);
+    RP_COUNT(vissprites,num_vissprite);
+
+#if RENDER_SORTED == 1
+    R_DrawWalls ();
+#endif
 
     R_DrawPlanes ();
 
     R_DrawMasked ();
+
+#if RENDER_THREADS > 0
+    R_FlushDrawQueue();
+#endif
+
+    NC_EndEpoch();
 }
 
 void V_DrawPatchNoScale(int x, int y, const patch_t* patch)
@@ -0,0 +1,120 @@
+/* Emacs style mode select   -*- C++ -*-
+ *-----------------------------------------------------------------------------
+ *
+ *
+ *  PrBoom: a Doom port merged with LxDoom and LSDLDoom
+ *  based on BOOM, a modified and improved DOOM engine
+ *  Copyright (C) 1999 by
+ *  id Software, Chi Hoang, Lee Killough, Jim Flynn, Rand Phares, Ty Halderman
+ *  Copyright (C) 1999-2000 by
+ *  Jess Haas, Nicolas Kalkhof, Colin Phipps, Florian Schulze
+ *  Copyright 2005, 2006 by
+ *  Florian Schulze, Colin Phipps, Neil Stevens, Andrey Budko
+ *  Copyright 2025 by
+ *  Brian Dam Pedersen
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License
+ *  as published by the Free Software Foundation; either version 2
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+ *  02111-1307, USA.
+ *
+ * DESCRIPTION:
+ *      Renderer profiler, see r_profile.h
+ *
+ *-----------------------------------------------------------------------------*/
+
+#include "r_profile.h"
+
+#include <string.h>
+
+static const char* const phasenames[RP_PHASES] = {
+    "bsp", "segs", "planes", "masked", "psprites", "statusbar", "hud", "blit", "other"
+};
+
+const char* RP_PhaseName(rp_phase_t phase)
+{
+    return (phase >= 0 && phase < RP_PHASES) ? phasenames[phase] : "";
+}
+
+#if RENDER_PROFILE == 1
+
+#include <time.h>
+
+#ifndef RP_STATS_FRAMES
+#define RP_STATS_FRAMES 16
+#endif
+
+#define RP_MAXDEPTH 8
+
+rp_framestats_t rp_frame;
+rp_phase_t rp_phase = RP_OTHER;
+
+static rp_framestats_t framestats[RP_STATS_FRAMES];
+static uint32_t frames = 0;
+
+// The stages that were interrupted by the ones nested in them
+static rp_phase_t outer[RP_MAXDEPTH];
+static int depth = 0;
+
+// When the current stage was entered or resumed
+static uint64_t phasestart = 0;
+
+static uint64_t RP_Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// Charge the time since the current stage was entered or resumed to it
+static void RP_Charge(void)
+{
+    uint64_t now = RP_Now();
+    if (phasestart)
+        rp_frame.ns[rp_phase] += (uint32_t)(now - phasestart);
+    phasestart = now;
+}
+
+void RP_Begin(rp_phase_t phase)
+{
+    RP_Charge();
+    if (depth < RP_MAXDEPTH)
+        outer[depth] = rp_phase;
+    depth++;
+    rp_phase = phase;
+}
+
+void RP_End(void)
+{
+    RP_Charge();
+    if (depth > 0 && --depth < RP_MAXDEPTH)
+        rp_phase = outer[depth];
+}
+
+void RP_EndFrame(void)
+{
+    RP_Charge();
+    rp_frame.frame = frames;
+    framestats[frames % RP_STATS_FRAMES] = rp_frame;
+    frames++;
+    memset(&rp_frame, 0, sizeof(rp_frame));
+}
+
+bool RP_GetFrameStats(int age, rp_framestats_t *stats)
+{
+    if (age < 0 || age >= RP_STATS_FRAMES || (uint32_t)age >= frames) return false;
+    *stats = framestats[(frames - 1 - age) % RP_STATS_FRAMES];
+    return true;
+}
+
+#endif
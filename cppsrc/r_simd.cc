@@ -0,0 +1,273 @@
+/* Emacs style mode select   -*- C++ -*-
+ *-----------------------------------------------------------------------------
+ *
+ *
+ *  PrBoom: a Doom port merged with LxDoom and LSDLDoom
+ *  based on BOOM, a modified and improved DOOM engine
+ *  Copyright (C) 1999 by
+ *  id Software, Chi Hoang, Lee Killough, Jim Flynn, Rand Phares, Ty Halderman
+ *  Copyright (C) 1999-2000 by
+ *  Jess Haas, Nicolas Kalkhof, Colin Phipps, Florian Schulze
+ *  Copyright 2005, 2006 by
+ *  Florian Schulze, Colin Phipps, Neil Stevens, Andrey Budko
+ *  Copyright 2025 by
+ *  Brian Dam Pedersen
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License
+ *  as published by the Free Software Foundation; either version 2
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+ *  02111-1307, USA.
+ *
+ * DESCRIPTION:
+ *      SIMD span and column drawers, see r_simd.h
+ *
+ *-----------------------------------------------------------------------------*/
+
+#include "r_simd.h"
+
+#if RENDER_SIMD == 1
+
+#include "doomdef.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define RS_X86
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define RS_NEON
+#endif
+
+// Texel of a flat at a span position, and of a column at a column frac (see R_DrawColumn())
+#define SPAN_INDEX(position) ((((position) >> 4) & 0x0fc0) | ((position) >> 26))
+#define COLUMN_INDEX(frac) ((frac) >> 25)
+
+static void DrawSpanScalar(unsigned short* dest, const uint8_t* source, const uint8_t* colormap, unsigned int position, unsigned int step, unsigned int count)
+{
+    while (count--)
+    {
+        const unsigned int color = colormap[source[SPAN_INDEX(position)]];
+        *dest++ = color | (color << 8);
+        position += step;
+    }
+}
+
+static void DrawColumnScalar(unsigned short* dest, const uint8_t* source, const uint8_t* colormap, unsigned int frac, unsigned int fracstep, int count)
+{
+    while (count-- > 0)
+    {
+        const unsigned int color = colormap[source[COLUMN_INDEX(frac)]];
+        *dest = color | (color << 8);
+        dest += SCREENWIDTH;
+        frac += fracstep;
+    }
+}
+
+#ifdef RS_X86
+/**
+ * SSE2 has no gathers, so the positions of 8 pixels are worked out at once and the lookups
+ * done one by one, and the 8 pixels are stored in one go. Columns gain nothing from that, as
+ * their pixels are a line apart.
+ */
+__attribute__((target("sse2")))
+static void DrawSpanSSE2(unsigned short* dest, const uint8_t* source, const uint8_t* colormap, unsigned int position, unsigned int step, unsigned int count)
+{
+    __m128i pos = _mm_setr_epi32(position, position + step, position + 2*step, position + 3*step);
+    const __m128i step4 = _mm_set1_epi32(4*step);
+    const __m128i mask = _mm_set1_epi32(0x0fc0);
+    alignas(16) uint32_t index[8];
+
+    for (; count >= 8; count -= 8, dest += 8)
+    {
+        const __m128i pos2 = _mm_add_epi32(pos, step4);
+        _mm_store_si128((__m128i*)&index[0], _mm_or_si128(_mm_and_si128(_mm_srli_epi32(pos, 4), mask), _mm_srli_epi32(pos, 26)));
+        _mm_store_si128((__m128i*)&index[4], _mm_or_si128(_mm_and_si128(_mm_srli_epi32(pos2, 4), mask), _mm_srli_epi32(pos2, 26)));
+        pos = _mm_add_epi32(pos2, step4);
+
+        const __m128i colors = _mm_setr_epi16(colormap[source[index[0]]], colormap[source[index[1]]],
+                                              colormap[source[index[2]]], colormap[source[index[3]]],
+                                              colormap[source[index[4]]], colormap[source[index[5]]],
+                                              colormap[source[index[6]]], colormap[source[index[7]]]);
+        _mm_storeu_si128((__m128i*)dest, _mm_or_si128(colors, _mm_slli_epi16(colors, 8)));
+    }
+
+    DrawSpanScalar(dest, source, colormap, _mm_cvtsi128_si32(pos), step, count);
+}
+
+/**
+ * Gather bytes at base[index] for 8 indexes. AVX2 gathers 32 bit words, so the aligned word
+ * holding each byte is read and shifted down. An aligned word never crosses a page, so this
+ * can't fault, but it can read up to 3 bytes outside the buffer - tools like valgrind will
+ * see that.
+ */
+__attribute__((target("avx2")))
+static inline __m256i GatherBytes(const uint8_t* base, __m256i index)
+{
+    const unsigned int misalign = (uintptr_t)base & 3;
+    const __m256i offset = _mm256_add_epi32(index, _mm256_set1_epi32(misalign));
+    const __m256i words = _mm256_i32gather_epi32((const int*)(base - misalign), _mm256_srli_epi32(offset, 2), 4);
+    const __m256i shift = _mm256_slli_epi32(_mm256_and_si256(offset, _mm256_set1_epi32(3)), 3);
+    return _mm256_and_si256(_mm256_srlv_epi32(words, shift), _mm256_set1_epi32(0xff));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i LookupColors(const uint8_t* source, const uint8_t* colormap, __m256i index)
+{
+    const __m256i colors = GatherBytes(colormap, GatherBytes(source, index));
+    return _mm256_or_si256(colors, _mm256_slli_epi32(colors, 8));
+}
+
+__attribute__((target("avx2")))
+static void DrawSpanAVX2(unsigned short* dest, const uint8_t* source, const uint8_t* colormap, unsigned int position, unsigned int step, unsigned int count)
+{
+    __m256i pos = _mm256_add_epi32(_mm256_set1_epi32(position), _mm256_mullo_epi32(_mm256_set1_epi32(step), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)));
+    const __m256i step8 = _mm256_set1_epi32(8*step);
+    const __m256i mask = _mm256_set1_epi32(0x0fc0);
+
+    for (; count >= 8; count -= 8, dest += 8)
+    {
+        const __m256i index = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(pos, 4), mask), _mm256_srli_epi32(pos, 26));
+        const __m256i colors = LookupColors(source, colormap, index);
+
+        // Pack the 8 pixels to 16 bits - packus works within the 128 bit lanes
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(colors, colors), 0x08);
+        _mm_storeu_si128((__m128i*)dest, _mm256_castsi256_si128(packed));
+
+        pos = _mm256_add_epi32(pos, step8);
+    }
+
+    DrawSpanScalar(dest, source, colormap, _mm256_cvtsi256_si32(pos), step, count);
+}
+
+__attribute__((target("avx2")))
+static void DrawColumnAVX2(unsigned short* dest, const uint8_t* source, const uint8_t* colormap, unsigned int frac, unsigned int fracstep, int count)
+{
+    __m256i pos = _mm256_add_epi32(_mm256_set1_epi32(frac), _mm256_mullo_epi32(_mm256_set1_epi32(fracstep), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)));
+    const __m256i step8 = _mm256_set1_epi32(8*fracstep);
+    alignas(32) uint32_t colors[8];
+
+    for (; count >= 8; count -= 8)
+    {
+        _mm256_store_si256((__m256i*)colors, LookupColors(source, colormap, _mm256_srli_epi32(pos, 25)));
+        pos = _mm256_add_epi32(pos, step8);
+
+        for (int i = 0; i < 8; i++, dest += SCREENWIDTH)
+            *dest = colors[i];
+    }
+
+    DrawColumnScalar(dest, source, colormap, _mm256_cvtsi256_si32(pos), fracstep, count);
+}
+#endif
+
+#ifdef RS_NEON
+// Like SSE2: positions of 8 pixels at once, lookups one by one, and the pixels stored together
+static void DrawSpanNEON(unsigned short* dest, const uint8_t* source, const uint8_t* colormap, unsigned int position, unsigned int step, unsigned int count)
+{
+    const uint32_t first[4] = {position, position + step, position + 2*step, position + 3*step};
+    uint32x4_t pos = vld1q_u32(first);
+    const uint32x4_t step4 = vdupq_n_u32(4*step);
+    const uint32x4_t mask = vdupq_n_u32(0x0fc0);
+    uint32_t index[8];
+    uint16_t colors[8];
+
+    for (; count >= 8; count -= 8, dest += 8)
+    {
+        const uint32x4_t pos2 = vaddq_u32(pos, step4);
+        vst1q_u32(&index[0], vorrq_u32(vandq_u32(vshrq_n_u32(pos, 4), mask), vshrq_n_u32(pos, 26)));
+        vst1q_u32(&index[4], vorrq_u32(vandq_u32(vshrq_n_u32(pos2, 4), mask), vshrq_n_u32(pos2, 26)));
+        pos = vaddq_u32(pos2, step4);
+
+        for (int i = 0; i < 8; i++)
+            colors[i] = colormap[source[index[i]]];
+
+        const uint16x8_t pixels = vld1q_u16(colors);
+        vst1q_u16(dest, vorrq_u16(pixels, vshlq_n_u16(pixels, 8)));
+    }
+
+    DrawSpanScalar(dest, source, colormap, vgetq_lane_u32(pos, 0), step, count);
+}
+#endif
+
+typedef struct {
+    const char* name;
+    bool (*supported)(void);
+    rs_drawspan_f span;
+    rs_drawcolumn_f column;
+} rs_drawers_t;
+
+static bool Always(void)
+{
+    return true;
+}
+
+#ifdef RS_X86
+static bool HasSSE2(void)
+{
+    return __builtin_cpu_supports("sse2");
+}
+
+static bool HasAVX2(void)
+{
+    return __builtin_cpu_supports("avx2");
+}
+#endif
+
+// Best first
+static const rs_drawers_t drawers[] = {
+#ifdef RS_X86
+    {"avx2", HasAVX2, DrawSpanAVX2, DrawColumnAVX2},
+    {"sse2", HasSSE2, DrawSpanSSE2, DrawColumnScalar},
+#endif
+#ifdef RS_NEON
+    {"neon", Always, DrawSpanNEON, DrawColumnScalar},
+#endif
+    {"scalar", Always, DrawSpanScalar, DrawColumnScalar},
+};
+
+rs_drawspan_f RS_DrawSpan = DrawSpanScalar;
+rs_drawcolumn_f RS_DrawColumn = DrawColumnScalar;
+
+// Pick the best drawers the CPU has, or the ones named by RENDER_SIMD, before the game starts
+static const char* SelectDrawers(void)
+{
+    const char* wanted = getenv("RENDER_SIMD");
+    const rs_drawers_t* best = nullptr;
+
+    for (const rs_drawers_t& d : drawers)
+    {
+        if (!d.supported())
+            continue;
+
+        if (!best || (wanted && !strcmp(wanted, d.name)))
+            best = &d;
+    }
+
+    if (wanted && strcmp(wanted, best->name))
+        printf("RENDER_SIMD=%s is not available, using %s\n", wanted, best->name);
+
+    RS_DrawSpan = best->span;
+    RS_DrawColumn = best->column;
+    return best->name;
+}
+
+static const char* rs_name = SelectDrawers();
+
+const char* RS_Name(void)
+{
+    return rs_name;
+}
+
+#endif
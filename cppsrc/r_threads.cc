@@ -0,0 +1,103 @@
+/* Emacs style mode select   -*- C++ -*-
+ *-----------------------------------------------------------------------------
+ *
+ *
+ *  PrBoom: a Doom port merged with LxDoom and LSDLDoom
+ *  based on BOOM, a modified and improved DOOM engine
+ *  Copyright (C) 1999 by
+ *  id Software, Chi Hoang, Lee Killough, Jim Flynn, Rand Phares, Ty Halderman
+ *  Copyright (C) 1999-2000 by
+ *  Jess Haas, Nicolas Kalkhof, Colin Phipps, Florian Schulze
+ *  Copyright 2005, 2006 by
+ *  Florian Schulze, Colin Phipps, Neil Stevens, Andrey Budko
+ *  Copyright 2025 by
+ *  Brian Dam Pedersen
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License
+ *  as published by the Free Software Foundation; either version 2
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+ *  02111-1307, USA.
+ *
+ * DESCRIPTION:
+ *      Worker pool for the render threads, see r_threads.h
+ *
+ *-----------------------------------------------------------------------------*/
+
+#include "r_threads.h"
+
+#if RENDER_THREADS > 0
+
+#include "doomdef.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+ * The workers wait for the generation to change, run the job on their strip and count down
+ * pending. Everything is allocated for good, as the workers are detached and still waiting
+ * when the program exits.
+ */
+typedef struct {
+    std::mutex lock;
+    std::condition_variable start;
+    std::condition_variable done;
+    void (*job)(int x1, int x2);
+    unsigned generation;
+    int pending;
+} rt_pool_t;
+
+static rt_pool_t *pool = nullptr;
+
+static inline int StripStart(int strip)
+{
+    return strip * SCREENWIDTH / RENDER_THREADS;
+}
+
+static void Worker(int strip)
+{
+    unsigned seen = 0;
+    std::unique_lock<std::mutex> lock(pool->lock);
+    for (;;) {
+        pool->start.wait(lock, [&]{ return pool->generation != seen; });
+        seen = pool->generation;
+        auto job = pool->job;
+        lock.unlock();
+        job(StripStart(strip),StripStart(strip+1));
+        lock.lock();
+        if (--pool->pending == 0) pool->done.notify_one();
+    }
+}
+
+void RT_Run(void (*job)(int x1, int x2))
+{
+    if (!pool) {
+        pool = new rt_pool_t();
+        for (int strip=1; strip<RENDER_THREADS; strip++)
+            std::thread(Worker,strip).detach();
+    }
+    {
+        std::lock_guard<std::mutex> lock(pool->lock);
+        pool->job = job;
+        pool->pending = RENDER_THREADS-1;
+        pool->generation++;
+    }
+    pool->start.notify_all();
+
+    job(StripStart(0),StripStart(1));
+
+    std::unique_lock<std::mutex> lock(pool->lock);
+    pool->done.wait(lock, [&]{ return pool->pending == 0; });
+}
+
+#endif
@@ -123,6 +123,12 @@ const uint8_t * NC_Pin(int lumpnum)
     return data;
 }
 
+const uint8_t * NC_PinRange(int lumpnum, int offset, int)
+{
+    // Always the whole lump
+    return NC_Pin(lumpnum)+offset;
+}
+
 void NC_Unpin(int lumpnum)
 {
     if (lumpnum == -1) return;
@@ -154,3 +160,81 @@ void NC_FlushCache(void)
     }
 }
 
+void NC_EndLevel(void)
+{
+    // Only one lump is ever held
+    NC_FlushCache();
+}
+
+void NC_Prefetch(int)
+{
+    // Every access allocates a fresh guarded copy, so there is nothing to load ahead of time
+}
+
+void NC_BeginLevel(int)
+{
+}
+
+void NC_LevelTic(void)
+{
+}
+
+const nc_stats_t* NC_GetStats(void)
+{
+    // Nothing is counted in this implementation
+    static nc_stats_t stats;
+    return &stats;
+}
+
+int NC_GetLumpMisses(int)
+{
+    return 0;
+}
+
+void NC_EndFrame(void)
+{
+}
+
+bool NC_GetFrameStats(int, nc_stats_t *)
+{
+    return false;
+}
+
+void NC_DescribeBlock(uint8_t *, struct th_blockinfo_s *)
+{
+}
+
+void NC_ServicePrefetch(void)
+{
+}
+
+void NC_IdleDefrag(void)
+{
+}
+
+// Epochs would hide stolen pointers from guardmalloc, so they are never entered here
+const uint8_t *nc_epochptrs[MAXLUMPS+1];
+
+void NC_BeginEpoch(void)
+{
+}
+
+void NC_EndEpoch(void)
+{
+}
+
+const uint8_t* NC_EpochPtr(int)
+{
+    return nullptr;
+}
+
+const uint8_t* NC_EpochCacheLumpNum(int lumpnum)
+{
+    return NC_CacheLumpNum(lumpnum);
+}
+
+const uint8_t* NC_EpochPin(int lumpnum, bool *pinned)
+{
+    *pinned = true;
+    return NC_Pin(lumpnum);
+}
@@ -0,0 +1,278 @@
+/**
+ * Tagheap allocation benchmark.
+ *
+ * Replays an allocation trace recorded by a build with TH_ALLOCTRACE=1 against the heap in
+ * ../tagheap.cc, built with the heap sizes given by TH_CACHEHEAPSIZE and TH_OBJECTHEAPSIZE on
+ * the command line. Blocks are known by where they were in the recording, so the heap being
+ * measured is free to put them elsewhere. Moves made by defrag in the recording only rename
+ * blocks - the replay defrags with its own callback, which allows every move as long as the
+ * tag tells which block it is (cache tags are lump numbers, so they do).
+ *
+ * Prints the time per call for each entry point, the peak fragmentation (1 - largest free
+ * block / free bytes) and the smallest largest free block of each heap, the bytes moved by
+ * defrag, and what blocks cost beyond their data. With a second argument, the free space of
+ * both heaps over the trace is written there as CSV every TH_BENCH_INTERVAL calls:
+ *   call,cachefree,cachelargest,cachefrag,objectfree,objectlargest,objectfrag,defragbytes
+ *
+ * Allocations that failed in the recording but fit here are freed right away, and ones that
+ * fail here but didn't in the recording are counted and their block left out from then on.
+ */
+
+#include "../tagheap.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <iterator>
+#include <unordered_map>
+
+#ifndef TH_BENCH_INTERVAL
+#define TH_BENCH_INTERVAL 1000
+#endif
+
+// A block of the recording and where it is in this heap
+typedef struct {
+    uint8_t *ptr;
+    uint32_t tag;
+} th_liveblock_t;
+
+static std::unordered_map<uint32_t, th_liveblock_t> live;
+static unsigned liveblocks[2], peakblocks[2]; // Per heap, 0 for the cache and 1 for objects
+
+// Cache blocks by tag for the defrag callback, or TH_TRACE_NULL when the tag is ambiguous
+static std::unordered_map<uint32_t, uint32_t> headblocks;
+
+static void Track(uint32_t key, uint8_t *ptr, uint32_t tag)
+{
+    auto old = live.find(key);
+    if (old != live.end()) liveblocks[old->second.tag >> 31]--;
+    live[key] = {ptr, tag};
+    int heap = tag >> 31;
+    if (++liveblocks[heap] > peakblocks[heap]) peakblocks[heap] = liveblocks[heap];
+    if (tag & 0x80000000) return;
+    auto it = headblocks.find(tag);
+    if (it == headblocks.end())
+        headblocks[tag] = key;
+    else
+        it->second = TH_TRACE_NULL;
+}
+
+static void Untrack(uint32_t key)
+{
+    auto it = live.find(key);
+    if (it == live.end()) return;
+    liveblocks[it->second.tag >> 31]--;
+    if (!(it->second.tag & 0x80000000)) {
+        auto head = headblocks.find(it->second.tag);
+        if (head != headblocks.end() && head->second == key) headblocks.erase(head);
+    }
+    live.erase(it);
+}
+
+static unsigned defragbytes = 0;
+
+static bool MoveBlock(short tag, uint8_t *newptr)
+{
+    auto it = headblocks.find((uint16_t)tag);
+    if (it == headblocks.end() || it->second == TH_TRACE_NULL) return false;
+    th_liveblock_t &block = live[it->second];
+    defragbytes += (TH_size((th_memblock_t *)block.ptr - 1) + 3) & ~3;
+    block.ptr = newptr;
+    return true;
+}
+
+typedef struct {
+    unsigned free;
+    unsigned largest;
+} th_freestats_t;
+
+// Walk the chain of the heap that tag belongs to
+static th_freestats_t FreeStats(uint32_t tag)
+{
+    th_freestats_t stats = {0, 0};
+    for (th_memblock_t *block = FIRSTBLOCK; block; block = TH_next(block)) {
+        if (TH_tag(block) != TH_FREE_TAG) continue;
+        stats.free += TH_size(block);
+        if (TH_size(block) > stats.largest) stats.largest = TH_size(block);
+    }
+    return stats;
+}
+
+static inline double Fragmentation(const th_freestats_t &stats)
+{
+    return stats.free ? 1.0 - (double)stats.largest / stats.free : 0.0;
+}
+
+enum { OP_ALLOC, OP_REALLOC, OP_FREE, OP_FREETAGS, OP_DEFRAG, OP_DEFRAGSTEP, OP_COUNT };
+static const char *opnames[OP_COUNT] = {"alloc", "realloc", "free", "freetags", "defrag", "defragstep"};
+
+int main(int argc, char **argv)
+{
+    if (argc != 2 && argc != 3) {
+        fprintf(stderr,"Usage: %s <thalloc.trace> [timeline.csv]\n",argv[0]);
+        return 1;
+    }
+    FILE *f = fopen(argv[1],"rb");
+    if (!f) {
+        fprintf(stderr,"Can't open %s\n",argv[1]);
+        return 1;
+    }
+    FILE *timeline = nullptr;
+    if (argc == 3) {
+        timeline = fopen(argv[2],"w");
+        if (!timeline) {
+            fprintf(stderr,"Can't open %s\n",argv[2]);
+            return 1;
+        }
+        fprintf(timeline,"call,cachefree,cachelargest,cachefrag,objectfree,objectlargest,objectfrag,defragbytes\n");
+    }
+    TH_init();
+
+    unsigned calls[OP_COUNT] = {};
+    double ns[OP_COUNT] = {};
+    unsigned total = 0, failed = 0, extra = 0, unknown = 0, recordedbytes = 0;
+    double peakfrag[2] = {0.0, 0.0};
+    unsigned minlargest[2] = {TH_CACHEHEAPSIZE, TH_OBJECTHEAPSIZE};
+
+    th_tracerecord_t rec;
+    while (fread(&rec,sizeof(rec),1,f) == 1) {
+        int op;
+        uint8_t *result = nullptr;
+        auto start = std::chrono::steady_clock::now();
+        switch (rec.op) {
+            case TH_TRACE_ALLOC:
+                op = OP_ALLOC;
+                result = TH_alloc(rec.size,rec.tag);
+                break;
+            case TH_TRACE_REALLOC: {
+                op = OP_REALLOC;
+                auto it = live.find(rec.ptr);
+                if (it == live.end()) {
+                    unknown++;
+                    continue;
+                }
+                start = std::chrono::steady_clock::now();
+                result = TH_realloc(it->second.ptr,rec.size);
+                break;
+            }
+            case TH_TRACE_FREE: {
+                op = OP_FREE;
+                auto it = live.find(rec.ptr);
+                if (it == live.end()) {
+                    unknown++;
+                    continue;
+                }
+                start = std::chrono::steady_clock::now();
+                TH_free(it->second.ptr);
+                break;
+            }
+            case TH_TRACE_FREETAGS:
+                op = OP_FREETAGS;
+                TH_freetags(rec.tag,rec.size);
+                break;
+            case TH_TRACE_DEFRAG:
+                op = OP_DEFRAG;
+                TH_defrag(MoveBlock);
+                break;
+            case TH_TRACE_DEFRAGSTEP:
+                op = OP_DEFRAGSTEP;
+                TH_defrag_step(MoveBlock,rec.size);
+                break;
+            case TH_TRACE_MOVE: {
+                // The block is called by its new address in the rest of the trace
+                recordedbytes += (rec.size + 3) & ~3;
+                auto it = live.find(rec.ptr);
+                if (it != live.end()) {
+                    th_liveblock_t block = it->second;
+                    Untrack(rec.ptr);
+                    Track(rec.result,block.ptr,block.tag);
+                }
+                continue;
+            }
+            default:
+                fprintf(stderr,"Unknown trace record '%c'\n",(char)rec.op);
+                return 1;
+        }
+        auto end = std::chrono::steady_clock::now();
+        ns[op] += std::chrono::duration<double, std::nano>(end - start).count();
+        calls[op]++;
+        total++;
+
+        // Keep track of the blocks
+        switch (op) {
+            case OP_ALLOC:
+                if (rec.result == TH_TRACE_NULL) {
+                    if (result) {
+                        TH_free(result);
+                        extra++;
+                    }
+                } else if (result) {
+                    Track(rec.result,result,rec.tag);
+                } else {
+                    failed++;
+                }
+                break;
+            case OP_REALLOC: {
+                th_liveblock_t block = live[rec.ptr];
+                Untrack(rec.ptr);
+                if ((int)rec.size <= 0) break; // Freed
+                if (result) {
+                    // A block that couldn't grow in the recording keeps its old address
+                    Track(rec.result == TH_TRACE_NULL ? rec.ptr : rec.result,result,block.tag);
+                } else if (rec.result != TH_TRACE_NULL) {
+                    failed++;
+                } else {
+                    Track(rec.ptr,block.ptr,block.tag);
+                }
+                break;
+            }
+            case OP_FREE:
+                Untrack(rec.ptr);
+                break;
+            case OP_FREETAGS:
+                for (auto it = live.begin(); it != live.end(); ) {
+                    auto next = std::next(it);
+                    if (rec.tag <= it->second.tag && it->second.tag <= rec.size) Untrack(it->first);
+                    it = next;
+                }
+                break;
+        }
+
+        th_freestats_t stats[2] = {FreeStats(0), FreeStats(0x80000000)};
+        for (int heap=0; heap<2; heap++) {
+            double frag = Fragmentation(stats[heap]);
+            if (frag > peakfrag[heap]) peakfrag[heap] = frag;
+            if (stats[heap].largest < minlargest[heap]) minlargest[heap] = stats[heap].largest;
+        }
+        if (timeline && total % TH_BENCH_INTERVAL == 0) {
+            fprintf(timeline,"%u,%u,%u,%.4f,%u,%u,%.4f,%u\n",total,
+                stats[0].free,stats[0].largest,Fragmentation(stats[0]),
+                stats[1].free,stats[1].largest,Fragmentation(stats[1]),defragbytes);
+        }
+    }
+    fclose(f);
+    if (timeline) fclose(timeline);
+
+    printf("Heap sizes: cache %d, objects %d bytes\n",TH_CACHEHEAPSIZE,TH_OBJECTHEAPSIZE);
+    printf("%-12s %10s %10s\n","call","count","ns/call");
+    double totalns = 0;
+    for (int op=0; op<OP_COUNT; op++) {
+        totalns += ns[op];
+        printf("%-12s %10u %10.1f\n",opnames[op],calls[op],calls[op] ? ns[op]/calls[op] : 0.0);
+    }
+    printf("%-12s %10u %10.1f\n","all",total,total ? totalns/total : 0.0);
+    printf("Peak fragmentation: cache %.4f, objects %.4f\n",peakfrag[0],peakfrag[1]);
+    printf("Smallest largest free block: cache %u, objects %u bytes\n",minlargest[0],minlargest[1]);
+    printf("Defrag bytes moved: %u (recording: %u)\n",defragbytes,recordedbytes);
+    printf("Allocations failed: %u, only succeeded here: %u, unknown blocks: %u\n",failed,extra,unknown);
+    // What each block costs beyond its data, against headers of two 32 bit pointers, a tag and a
+    // size as on the target. Object blocks pay for their tag list links out of the saving.
+    const int oldheader = 16;
+    int overhead[2] = {(int)sizeof(th_memblock_t), (int)(sizeof(th_memblock_t) + TH_TAGLINKSIZE)};
+    printf("Bytes per block: cache %d, objects %d (%d with the old header)\n",overhead[0],overhead[1],oldheader);
+    printf("Peak live blocks: cache %u, objects %u, saving %d bytes against the old header\n",
+        peakblocks[0],peakblocks[1],
+        (int)peakblocks[0]*(oldheader - overhead[0]) + (int)peakblocks[1]*(oldheader - overhead[1]));
+    return 0;
+}
@@ -4645,8 +4645,1363 @@ uint32_t CONSTMEM _lumpname_low[WADLUMPS] = {
     0x59414c50,
 };
 
+uint32_t CONSTMEM _lumphash_seed[LUMPHASH_BUCKETS] = {
+    191,
+    135,
+    3,
+    39,
+    12,
+    11,
+    2,
+    26,
+    56,
+    19,
+    3,
+    213,
+    4,
+    183,
+    42,
+    1,
+    230,
+    2,
+    28,
+    172,
+    1,
+    80,
+    1,
+    265,
+    21,
+    177,
+    4,
+    1,
+    10,
+    8,
+    7,
+    2,
+    2,
+    30,
+    20,
+    500,
+    1,
+    34,
+    36,
+    33,
+    1,
+    2,
+    6,
+    51,
+    0,
+    944,
+    41,
+    32,
+    204,
+    5,
+    344,
+    204,
+    2,
+    1,
+    1,
+    8,
+    21,
+    7,
+    26,
+    519,
+    1,
+    7,
+    9,
+    154,
+    53,
+    202,
+    9,
+    3,
+    364,
+    21,
+    0,
+    155,
+    526,
+    46,
+    3,
+    240,
+    80,
+    601,
+    21,
+    85,
+    7,
+    58,
+    12,
+    45,
+    14,
+    52,
+    9,
+    189,
+    6,
+    28,
+    3,
+    4,
+    68,
+    1,
+    14,
+    11,
+    8,
+    1,
+    40,
+    129,
+    151,
+    41,
+    42,
+    1,
+    9,
+    67,
+    7,
+    15,
+    23,
+    19,
+    20,
+    7,
+    5,
+    10,
+    48,
+    6,
+    9,
+    76,
+    3,
+    36,
+    231,
+    351,
+    66,
+    100,
+    11,
+    55,
+    156,
+    100,
+    16,
+    484,
+    6,
+    1,
+    128,
+    35,
+    150,
+    69,
+    3,
+    25,
+    3,
+    222,
+    141,
+    146,
+    3,
+    63,
+    4,
+    4,
+    170,
+    3,
+    505,
+    13,
+    3,
+    718,
+    13,
+    192,
+    139,
+    1,
+    7,
+    81,
+    142,
+    0,
+    5,
+    4,
+    30,
+    139,
+    666,
+    444,
+    129,
+    114,
+    25,
+    1,
+    103,
+    197,
+    472,
+    18,
+    288,
+    792,
+    349,
+    4,
+    2,
+    24,
+    21,
+    1,
+    19,
+    81,
+    12,
+    1985,
+    427,
+    8,
+    17,
+    27,
+    53,
+    12,
+    179,
+    29,
+    1273,
+    2,
+    325,
+    148,
+    433,
+    2,
+    1,
+    245,
+    878,
+    442,
+    153,
+    73,
+    123,
+    1475,
+    195,
+    2,
+    327,
+    541,
+    1,
+    0,
+    77,
+    0,
+    35,
+    210,
+    2137,
+    2,
+    287,
+    794,
+    18,
+    340,
+    94,
+    23,
+    1522,
+    485,
+    0,
+    3076,
+    603,
+    11,
+    520,
+    264,
+    3,
+    2,
+    40,
+    7,
+    5,
+    64,
+    7,
+    1641,
+    359,
+    16,
+    367,
+    50,
+    57,
+    11,
+    1241,
+    119,
+    144,
+    455,
+    4,
+    1186,
+    4,
+    2708,
+    1,
+    2,
+    803,
+    3278,
+    656,
+    2,
+    2731,
+    174,
+    1,
+    580,
+    18,
+    608,
+    300,
+    2,
+};
+
+int32_t CONSTMEM _lumphash_index[LUMPHASH_SLOTS] = {
+    592,
+    1135,
+    278,
+    397,
+    742,
+    488,
+    552,
+    462,
+    623,
+    666,
+    585,
+    572,
+    1049,
+    1098,
+    337,
+    610,
+    1017,
+    5,
+    575,
+    968,
+    536,
+    1025,
+    697,
+    554,
+    919,
+    218,
+    901,
+    738,
+    348,
+    582,
+    324,
+    438,
+    1048,
+    387,
+    336,
+    465,
+    199,
+    453,
+    660,
+    799,
+    853,
+    667,
+    339,
+    642,
+    1072,
+    111,
+    841,
+    511,
+    313,
+    484,
+    856,
+    517,
+    535,
+    294,
+    1142,
+    131,
+    811,
+    537,
+    1009,
+    977,
+    203,
+    1030,
+    731,
+    583,
+    580,
+    577,
+    143,
+    390,
+    308,
+    406,
+    1058,
+    282,
+    1023,
+    146,
+    918,
+    321,
+    559,
+    501,
+    980,
+    503,
+    607,
+    958,
+    732,
+    886,
+    929,
+    713,
+    188,
+    686,
+    412,
+    1152,
+    233,
+    947,
+    1055,
+    471,
+    1059,
+    152,
+    843,
+    1065,
+    194,
+    230,
+    216,
+    284,
+    848,
+    472,
+    814,
+    820,
+    768,
+    15,
+    619,
+    422,
+    902,
+    160,
+    185,
+    645,
+    815,
+    0,
+    236,
+    424,
+    266,
+    586,
+    850,
+    976,
+    1117,
+    760,
+    631,
+    922,
+    507,
+    411,
+    698,
+    352,
+    927,
+    162,
+    696,
+    451,
+    317,
+    617,
+    833,
+    385,
+    137,
+    17,
+    334,
+    1066,
+    195,
+    900,
+    948,
+    289,
+    310,
+    369,
+    271,
+    613,
+    1010,
+    661,
+    716,
+    540,
+    1037,
+    273,
+    917,
+    142,
+    520,
+    219,
+    498,
+    1004,
+    663,
+    502,
+    1028,
+    380,
+    584,
+    1021,
+    1147,
+    437,
+    306,
+    981,
+    966,
+    395,
+    292,
+    487,
+    285,
+    868,
+    267,
+    356,
+    685,
+    360,
+    794,
+    522,
+    639,
+    430,
+    571,
+    140,
+    389,
+    183,
+    445,
+    477,
+    626,
+    855,
+    741,
+    1121,
+    1013,
+    569,
+    641,
+    1154,
+    6,
+    130,
+    1022,
+    961,
+    1014,
+    1075,
+    441,
+    512,
+    1054,
+    1123,
+    393,
+    531,
+    342,
+    857,
+    993,
+    480,
+    449,
+    1099,
+    758,
+    989,
+    932,
+    121,
+    207,
+    375,
+    1105,
+    945,
+    544,
+    225,
+    167,
+    434,
+    818,
+    939,
+    364,
+    256,
+    890,
+    877,
+    774,
+    616,
+    701,
+    407,
+    979,
+    519,
+    120,
+    298,
+    795,
+    132,
+    499,
+    107,
+    985,
+    529,
+    861,
+    1001,
+    455,
+    595,
+    1006,
+    398,
+    296,
+    906,
+    159,
+    896,
+    355,
+    960,
+    365,
+    549,
+    750,
+    227,
+    1092,
+    638,
+    238,
+    105,
+    556,
+    867,
+    581,
+    249,
+    378,
+    1047,
+    275,
+    936,
+    715,
+    733,
+    370,
+    362,
+    118,
+    844,
+    1106,
+    1050,
+    937,
+    515,
+    865,
+    428,
+    1042,
+    956,
+    735,
+    578,
+    1083,
+    874,
+    802,
+    783,
+    205,
+    476,
+    675,
+    1056,
+    872,
+    486,
+    1096,
+    720,
+    280,
+    1104,
+    344,
+    527,
+    812,
+    479,
+    1124,
+    326,
+    722,
+    602,
+    1146,
+    539,
+    211,
+    589,
+    570,
+    840,
+    659,
+    926,
+    999,
+    259,
+    270,
+    629,
+    3,
+    122,
+    971,
+    246,
+    166,
+    778,
+    930,
+    405,
+    426,
+    618,
+    1051,
+    148,
+    228,
+    725,
+    1045,
+    1019,
+    608,
+    260,
+    350,
+    620,
+    852,
+    746,
+    1,
+    729,
+    459,
+    466,
+    338,
+    244,
+    119,
+    793,
+    658,
+    217,
+    763,
+    789,
+    303,
+    416,
+    359,
+    173,
+    223,
+    991,
+    440,
+    1071,
+    934,
+    908,
+    949,
+    1000,
+    269,
+    11,
+    788,
+    627,
+    757,
+    588,
+    928,
+    624,
+    257,
+    767,
+    1126,
+    333,
+    705,
+    826,
+    373,
+    555,
+    231,
+    756,
+    417,
+    1002,
+    967,
+    1102,
+    186,
+    647,
+    1139,
+    302,
+    1091,
+    1130,
+    504,
+    677,
+    568,
+    1107,
+    810,
+    125,
+    587,
+    770,
+    693,
+    538,
+    214,
+    880,
+    747,
+    213,
+    394,
+    1137,
+    314,
+    1100,
+    816,
+    831,
+    399,
+    775,
+    288,
+    485,
+    558,
+    127,
+    431,
+    903,
+    381,
+    1094,
+    648,
+    689,
+    699,
+    825,
+    396,
+    83,
+    1157,
+    1134,
+    594,
+    110,
+    311,
+    1053,
+    180,
+    490,
+    458,
+    197,
+    325,
+    346,
+    392,
+    176,
+    408,
+    509,
+    391,
+    863,
+    28,
+    212,
+    464,
+    513,
+    496,
+    533,
+    914,
+    461,
+    904,
+    621,
+    832,
+    1038,
+    1128,
+    454,
+    766,
+    1129,
+    1069,
+    1084,
+    425,
+    553,
+    942,
+    1005,
+    965,
+    761,
+    409,
+    891,
+    299,
+    548,
+    239,
+    456,
+    368,
+    329,
+    452,
+    864,
+    871,
+    962,
+    423,
+    116,
+    912,
+    138,
+    1078,
+    331,
+    809,
+    669,
+    506,
+    679,
+    1061,
+    448,
+    1067,
+    109,
+    797,
+    827,
+    413,
+    779,
+    541,
+    690,
+    528,
+    16,
+    526,
+    700,
+    1081,
+    800,
+    129,
+    483,
+    813,
+    796,
+    873,
+    1044,
+    834,
+    332,
+    649,
+    221,
+    973,
+    1119,
+    495,
+    382,
+    514,
+    888,
+    290,
+    737,
+    328,
+    220,
+    172,
+    184,
+    847,
+    436,
+    12,
+    1148,
+    354,
+    916,
+    126,
+    724,
+    295,
+    1097,
+    9,
+    388,
+    625,
+    500,
+    492,
+    1133,
+    193,
+    427,
+    743,
+    703,
+    1074,
+    1015,
+    664,
+    644,
+    469,
+    923,
+    376,
+    1027,
+    377,
+    1131,
+    806,
+    935,
+    726,
+    1034,
+    593,
+    1062,
+    674,
+    723,
+    702,
+    307,
+    776,
+    153,
+    200,
+    347,
+    1064,
+    1138,
+    265,
+    518,
+    845,
+    1087,
+    372,
+    156,
+    175,
+    291,
+    279,
+    694,
+    881,
+    262,
+    145,
+    893,
+    446,
+    215,
+    1031,
+    708,
+    803,
+    597,
+    1156,
+    941,
+    14,
+    823,
+    736,
+    351,
+    862,
+    551,
+    972,
+    202,
+    887,
+    530,
+    565,
+    250,
+    433,
+    1151,
+    174,
+    8,
+    190,
+    251,
+    112,
+    734,
+    1141,
+    357,
+    253,
+    943,
+    1036,
+    263,
+    772,
+    662,
+    1089,
+    804,
+    1109,
+    128,
+    754,
+    992,
+    839,
+    196,
+    1011,
+    974,
+    371,
+    562,
+    828,
+    157,
+    640,
+    232,
+    695,
+    1040,
+    255,
+    470,
+    676,
+    415,
+    744,
+    224,
+    566,
+    335,
+    1101,
+    403,
+    1024,
+    1155,
+    849,
+    374,
+    305,
+    655,
+    899,
+    151,
+    1029,
+    876,
+    330,
+    915,
+    468,
+    909,
+    243,
+    432,
+    384,
+    420,
+    1127,
+    753,
+    798,
+    925,
+    986,
+    635,
+    759,
+    897,
+    996,
+    124,
+    907,
+    835,
+    609,
+    604,
+    573,
+    482,
+    421,
+    790,
+    905,
+    182,
+    931,
+    323,
+    777,
+    547,
+    439,
+    179,
+    366,
+    955,
+    755,
+    984,
+    837,
+    854,
+    463,
+    1041,
+    481,
+    1113,
+    252,
+    670,
+    591,
+    363,
+    1149,
+    210,
+    546,
+    665,
+    911,
+    668,
+    940,
+    611,
+    892,
+    622,
+    650,
+    600,
+    135,
+    208,
+    473,
+    784,
+    842,
+    13,
+    108,
+    1118,
+    1007,
+    728,
+    450,
+    1136,
+    970,
+    884,
+    739,
+    590,
+    1079,
+    765,
+    240,
+    287,
+    155,
+    178,
+    61,
+    969,
+    819,
+    1080,
+    680,
+    510,
+    4,
+    429,
+    1026,
+    340,
+    808,
+    858,
+    532,
+    1153,
+    379,
+    651,
+    711,
+    1090,
+    879,
+    1063,
+    785,
+    557,
+    998,
+    254,
+    341,
+    762,
+    264,
+    177,
+    601,
+    139,
+    1111,
+    646,
+    206,
+    748,
+    1033,
+    404,
+    545,
+    2,
+    242,
+    247,
+    714,
+    1112,
+    878,
+    727,
+    505,
+    72,
+    567,
+    524,
+    343,
+    933,
+    1057,
+    870,
+    147,
+    494,
+    222,
+    1020,
+    274,
+    1093,
+    383,
+    261,
+    293,
+    612,
+    889,
+    327,
+    1150,
+    953,
+    170,
+    704,
+    318,
+    1095,
+    684,
+    460,
+    563,
+    751,
+    516,
+    764,
+    301,
+    367,
+    921,
+    281,
+    678,
+    898,
+    946,
+    1122,
+    682,
+    630,
+    115,
+    534,
+    478,
+    493,
+    885,
+    154,
+    615,
+    134,
+    442,
+    780,
+    1103,
+    882,
+    988,
+    730,
+    598,
+    1018,
+    654,
+    1125,
+    954,
+    643,
+    894,
+    1073,
+    286,
+    144,
+    123,
+    133,
+    1032,
+    248,
+    277,
+    550,
+    838,
+    1145,
+    349,
+    749,
+    444,
+    315,
+    268,
+    229,
+    924,
+    801,
+    106,
+    920,
+    192,
+    706,
+    201,
+    258,
+    209,
+    740,
+    94,
+    628,
+    164,
+    636,
+    657,
+    1046,
+    829,
+    787,
+    910,
+    39,
+    652,
+    1120,
+    165,
+    1052,
+    1035,
+    1114,
+    141,
+    1068,
+    189,
+    322,
+    709,
+    168,
+    987,
+    564,
+    457,
+    161,
+    830,
+    1110,
+    673,
+    869,
+    467,
+    781,
+    603,
+    614,
+    1143,
+    491,
+    773,
+    542,
+    1086,
+    113,
+    913,
+    712,
+    817,
+    358,
+    418,
+    319,
+    272,
+    316,
+    717,
+    1016,
+    353,
+    786,
+    226,
+    653,
+    859,
+    447,
+    634,
+    994,
+    312,
+    574,
+    204,
+    688,
+    187,
+    419,
+    792,
+    1085,
+    824,
+    599,
+    401,
+    860,
+    978,
+    1043,
+    304,
+    414,
+    822,
+    983,
+    191,
+    297,
+    245,
+    50,
+    1003,
+    895,
+    169,
+    474,
+    633,
+    443,
+    171,
+    606,
+    114,
+    475,
+    525,
+    1115,
+    10,
+    964,
+    821,
+    782,
+    579,
+    952,
+    875,
+    851,
+    1008,
+    7,
+    345,
+    938,
+    235,
+    791,
+    605,
+    410,
+    561,
+    150,
+    241,
+    158,
+    1140,
+    508,
+    435,
+    681,
+    951,
+    692,
+    671,
+    136,
+    771,
+    596,
+    745,
+    963,
+    1116,
+    309,
+    719,
+    846,
+    1070,
+    163,
+    283,
+    710,
+    957,
+    718,
+    198,
+    707,
+    656,
+    402,
+    1082,
+    975,
+    117,
+    836,
+    320,
+    276,
+    1039,
+    149,
+    637,
+    1144,
+    883,
+    769,
+    1088,
+    721,
+    1060,
+    523,
+    1132,
+    995,
+    1108,
+    990,
+    300,
+    807,
+    386,
+    1077,
+    489,
+    944,
+    687,
+    361,
+    543,
+    752,
+    691,
+    959,
+    234,
+    497,
+    576,
+    866,
+    632,
+    400,
+    805,
+    1012,
+    1076,
+    521,
+    237,
+    950,
+    683,
+    982,
+    560,
+    672,
+    181,
+};
+
 // Array representations
 ConstMemArray<int32_t> filepos(_filepos);
 ConstMemArray<int32_t> lumpsize(_lumpsize);
 ConstMemArray<uint32_t> lumpname_high(_lumpname_high);
 ConstMemArray<uint32_t> lumpname_low(_lumpname_low);
+ConstMemArray<uint32_t> lumphash_seed(_lumphash_seed);
+ConstMemArray<int32_t> lumphash_index(_lumphash_index);
@@ -0,0 +1,7169 @@
+#include "gbadoom1z_lumps.h"
+#include "annotations.h"
+
+int32_t CONSTMEM _filepos[WADLUMPS] = {
+    18540,
+    29292,
+    35171,
+    36721,
+    49102,
+    58555,
+    63807,
+    63807,
+    64860,
+    81100,
+    83546,
+    86161,
+    100383,
+    101331,
+    106892,
+    107694,
+    108264,
+    112381,
+    112381,
+    114357,
+    149513,
+    155492,
+    160754,
+    189202,
+    190994,
+    201423,
+    203119,
+    205264,
+    212872,
+    212872,
+    215662,
+    251009,
+    256288,
+    261663,
+    289471,
+    291315,
+    302234,
+    303848,
+    305715,
+    312122,
+    312122,
+    314023,
+    342902,
+    347372,
+    351712,
+    374611,
+    376031,
+    384344,
+    385732,
+    387263,
+    392594,
+    392594,
+    394822,
+    423570,
+    428002,
+    432231,
+    454431,
+    455967,
+    465041,
+    466444,
+    468093,
+    473510,
+    473510,
+    476973,
+    522252,
+    529275,
+    535982,
+    571911,
+    574335,
+    588275,
+    590177,
+    593095,
+    603242,
+    603242,
+    605848,
+    638979,
+    644379,
+    649414,
+    676087,
+    677955,
+    688954,
+    690594,
+    692280,
+    698530,
+    698530,
+    699413,
+    710599,
+    712736,
+    714558,
+    725826,
+    726534,
+    730520,
+    731091,
+    731300,
+    739848,
+    739848,
+    741561,
+    762921,
+    766565,
+    769722,
+    788536,
+    789688,
+    796185,
+    797100,
+    798969,
+    803672,
+    808303,
+    810206,
+    813642,
+    854915,
+    900705,
+    943409,
+    993390,
+    993438,
+    993470,
+    993530,
+    993590,
+    993634,
+    993685,
+    993741,
+    993793,
+    993846,
+    993898,
+    1001496,
+    1001564,
+    1001628,
+    1001704,
+    1001776,
+    1001836,
+    1001908,
+    1001980,
+    1002052,
+    1002128,
+    1002200,
+    1002301,
+    1002621,
+    1002803,
+    1003068,
+    1003334,
+    1003575,
+    1003854,
+    1004132,
+    1004332,
+    1004599,
+    1004871,
+    1005141,
+    1005209,
+    1005273,
+    1005349,
+    1005421,
+    1005481,
+    1005553,
+    1005625,
+    1005697,
+    1005773,
+    1005845,
+    1005927,
+    1006006,
+    1006088,
+    1006185,
+    1006283,
+    1006384,
+    1006594,
+    1006922,
+    1008178,
+    1008237,
+    1008305,
+    1008398,
+    1008509,
+    1008633,
+    1008765,
+    1008825,
+    1008945,
+    1009065,
+    1009146,
+    1009222,
+    1009282,
+    1009338,
+    1009394,
+    1009494,
+    1009595,
+    1009668,
+    1009780,
+    1009892,
+    1009991,
+    1010091,
+    1010205,
+    1010310,
+    1010414,
+    1010529,
+    1010598,
+    1010656,
+    1010736,
+    1010796,
+    1010876,
+    1010982,
+    1011108,
+    1011216,
+    1011330,
+    1011451,
+    1011566,
+    1011678,
+    1011781,
+    1011889,
+    1011993,
+    1012052,
+    1012157,
+    1012275,
+    1012365,
+    1012490,
+    1012604,
+    1012707,
+    1012813,
+    1012929,
+    1013042,
+    1013144,
+    1013249,
+    1013353,
+    1013461,
+    1013579,
+    1013707,
+    1013813,
+    1013917,
+    1013998,
+    1014098,
+    1014190,
+    1014272,
+    1014336,
+    1014395,
+    1014576,
+    1014757,
+    1014938,
+    1015119,
+    1015303,
+    1015487,
+    1015671,
+    1015855,
+    1016450,
+    1017060,
+    1017670,
+    1018554,
+    1019434,
+    1020105,
+    1020695,
+    1021275,
+    1021904,
+    1022712,
+    1023512,
+    1024396,
+    1025284,
+    1025962,
+    1026606,
+    1027223,
+    1027871,
+    1028559,
+    1029243,
+    1030139,
+    1031035,
+    1031741,
+    1032402,
+    1033043,
+    1033741,
+    1034581,
+    1035413,
+    1036357,
+    1037265,
+    1037966,
+    1038638,
+    1039257,
+    1039986,
+    1040830,
+    1041674,
+    1042658,
+    1043566,
+    1044299,
+    1045003,
+    1045683,
+    1046269,
+    1047105,
+    1052447,
+    1054164,
+    1055583,
+    1057324,
+    1058866,
+    1059242,
+    1059620,
+    1059728,
+    1059833,
+    1059972,
+    1060082,
+    1061755,
+    1062844,
+    1064226,
+    1064730,
+    1065220,
+    1067528,
+    1070188,
+    1072675,
+    1073860,
+    1076065,
+    1078677,
+    1081327,
+    1084110,
+    1085797,
+    1088298,
+    1090416,
+    1092551,
+    1093977,
+    1095550,
+    1097202,
+    1098491,
+    1100739,
+    1101333,
+    1101969,
+    1104293,
+    1106876,
+    1108533,
+    1110325,
+    1112223,
+    1114193,
+    1116271,
+    1116430,
+    1116580,
+    1116740,
+    1116784,
+    1116871,
+    1116915,
+    1116975,
+    1117035,
+    1117079,
+    1117163,
+    1117200,
+    1168712,
+    1168856,
+    1169000,
+    1169144,
+    1169352,
+    1169560,
+    1169768,
+    1169976,
+    1170184,
+    1170392,
+    1170536,
+    1170680,
+    1170824,
+    1170968,
+    1171112,
+    1171256,
+    1171400,
+    1171544,
+    1171688,
+    1171868,
+    1172050,
+    1172232,
+    1172440,
+    1172648,
+    1172856,
+    1173215,
+    1173574,
+    1173933,
+    1174077,
+    1174221,
+    1174345,
+    1175081,
+    1175808,
+    1176452,
+    1177202,
+    1178081,
+    1179357,
+    1180223,
+    1181013,
+    1181231,
+    1181898,
+    1182525,
+    1183216,
+    1183282,
+    1183508,
+    1183690,
+    1183807,
+    1183999,
+    1184181,
+    1184357,
+    1184548,
+    1184740,
+    1184895,
+    1185086,
+    1185283,
+    1185367,
+    1186332,
+    1187194,
+    1188406,
+    1190341,
+    1192209,
+    1194355,
+    1196008,
+    1198656,
+    1201260,
+    1203583,
+    1205606,
+    1207785,
+    1208942,
+    1211076,
+    1213726,
+    1215726,
+    1217747,
+    1220030,
+    1221267,
+    1223949,
+    1225852,
+    1227938,
+    1230530,
+    1232101,
+    1234046,
+    1234600,
+    1235974,
+    1237769,
+    1239926,
+    1240251,
+    1240657,
+    1241052,
+    1241431,
+    1241756,
+    1242162,
+    1242557,
+    1242935,
+    1243328,
+    1243963,
+    1244989,
+    1246194,
+    1246194,
+    1254374,
+    1261446,
+    1263614,
+    1265486,
+    1270402,
+    1275333,
+    1280790,
+    1286374,
+    1289006,
+    1292774,
+    1296438,
+    1300054,
+    1304946,
+    1306354,
+    1306674,
+    1306994,
+    1308310,
+    1309593,
+    1311150,
+    1311226,
+    1311370,
+    1311626,
+    1312002,
+    1312078,
+    1312210,
+    1312426,
+    1312766,
+    1313082,
+    1314966,
+    1317326,
+    1319129,
+    1322917,
+    1327677,
+    1330551,
+    1332735,
+    1334431,
+    1335827,
+    1336847,
+    1337239,
+    1337391,
+    1337435,
+    1337523,
+    1337669,
+    1337880,
+    1339040,
+    1339934,
+    1340322,
+    1340466,
+    1340510,
+    1340722,
+    1340937,
+    1341565,
+    1342581,
+    1343300,
+    1343760,
+    1343847,
+    1344951,
+    1346279,
+    1347867,
+    1349211,
+    1350155,
+    1351247,
+    1352579,
+    1354167,
+    1355399,
+    1356155,
+    1357323,
+    1358560,
+    1359682,
+    1360869,
+    1363981,
+    1366577,
+    1370729,
+    1376517,
+    1379515,
+    1382732,
+    1384045,
+    1386721,
+    1390496,
+    1393508,
+    1393728,
+    1394190,
+    1394777,
+    1395170,
+    1395382,
+    1397528,
+    1404272,
+    1411003,
+    1418180,
+    1419189,
+    1420463,
+    1422463,
+    1424847,
+    1427235,
+    1429395,
+    1431035,
+    1433115,
+    1435155,
+    1437319,
+    1439375,
+    1440870,
+    1442866,
+    1445038,
+    1447326,
+    1449314,
+    1450954,
+    1453034,
+    1455178,
+    1457354,
+    1459186,
+    1460684,
+    1462828,
+    1464748,
+    1466980,
+    1469008,
+    1470545,
+    1472361,
+    1474697,
+    1476913,
+    1479061,
+    1481185,
+    1483745,
+    1485889,
+    1487617,
+    1489581,
+    1492241,
+    1494697,
+    1496869,
+    1498881,
+    1501317,
+    1503405,
+    1505170,
+    1507106,
+    1509634,
+    1511926,
+    1514014,
+    1515986,
+    1518158,
+    1520158,
+    1521419,
+    1523115,
+    1525271,
+    1527379,
+    1529719,
+    1531967,
+    1533867,
+    1535775,
+    1537611,
+    1539339,
+    1540733,
+    1542297,
+    1543441,
+    1544489,
+    1545511,
+    1546868,
+    1548288,
+    1549592,
+    1550820,
+    1551792,
+    1553175,
+    1554703,
+    1555851,
+    1556911,
+    1557935,
+    1559249,
+    1560901,
+    1562221,
+    1563233,
+    1564381,
+    1566061,
+    1567321,
+    1568605,
+    1569698,
+    1570716,
+    1572304,
+    1573780,
+    1575160,
+    1576188,
+    1577352,
+    1578680,
+    1580324,
+    1582024,
+    1583182,
+    1584294,
+    1585746,
+    1586890,
+    1588218,
+    1589554,
+    1590726,
+    1592318,
+    1593822,
+    1595122,
+    1596414,
+    1597646,
+    1599858,
+    1602406,
+    1605258,
+    1607834,
+    1609842,
+    1611666,
+    1613122,
+    1614362,
+    1616650,
+    1618830,
+    1621286,
+    1623470,
+    1625618,
+    1628410,
+    1630822,
+    1632822,
+    1634978,
+    1637510,
+    1639798,
+    1642278,
+    1644678,
+    1646702,
+    1648850,
+    1651638,
+    1654018,
+    1656038,
+    1658262,
+    1660794,
+    1663586,
+    1665622,
+    1668130,
+    1670862,
+    1673402,
+    1675526,
+    1677906,
+    1680890,
+    1683958,
+    1686562,
+    1688878,
+    1691414,
+    1693958,
+    1696426,
+    1698538,
+    1701130,
+    1703530,
+    1706254,
+    1708562,
+    1710778,
+    1712994,
+    1715326,
+    1717526,
+    1719878,
+    1722570,
+    1724942,
+    1727450,
+    1729774,
+    1732150,
+    1734350,
+    1736622,
+    1739058,
+    1741750,
+    1744326,
+    1746830,
+    1748862,
+    1750622,
+    1752406,
+    1754190,
+    1754614,
+    1755190,
+    1755938,
+    1756446,
+    1756840,
+    1757408,
+    1758176,
+    1758696,
+    1759716,
+    1760828,
+    1762297,
+    1763717,
+    1765049,
+    1766473,
+    1767861,
+    1769081,
+    1770533,
+    1771821,
+    1773121,
+    1774509,
+    1775821,
+    1777253,
+    1778689,
+    1779993,
+    1781345,
+    1782689,
+    1784129,
+    1785529,
+    1786757,
+    1788057,
+    1789405,
+    1790681,
+    1792049,
+    1793649,
+    1795069,
+    1796241,
+    1797521,
+    1798933,
+    1800581,
+    1802077,
+    1803197,
+    1804689,
+    1806005,
+    1807489,
+    1808985,
+    1810381,
+    1812017,
+    1813445,
+    1814977,
+    1816389,
+    1817437,
+    1818489,
+    1819549,
+    1821217,
+    1823521,
+    1825953,
+    1828257,
+    1830225,
+    1831973,
+    1833577,
+    1834961,
+    1836325,
+    1837717,
+    1839033,
+    1840441,
+    1841793,
+    1843013,
+    1844429,
+    1845689,
+    1846973,
+    1848329,
+    1849629,
+    1851033,
+    1852445,
+    1853749,
+    1855085,
+    1856421,
+    1857849,
+    1859221,
+    1860429,
+    1861721,
+    1863033,
+    1864281,
+    1865637,
+    1867221,
+    1868641,
+    1869797,
+    1871045,
+    1872461,
+    1874105,
+    1875585,
+    1876697,
+    1878181,
+    1879469,
+    1880893,
+    1882365,
+    1883749,
+    1885353,
+    1886629,
+    1887853,
+    1888981,
+    1889969,
+    1891793,
+    1894201,
+    1896725,
+    1899093,
+    1901085,
+    1902857,
+    1904497,
+    1905961,
+    1907313,
+    1908629,
+    1909853,
+    1911173,
+    1912493,
+    1913705,
+    1915089,
+    1916193,
+    1917329,
+    1918641,
+    1919760,
+    1921096,
+    1922324,
+    1923580,
+    1924844,
+    1925991,
+    1927355,
+    1928595,
+    1929723,
+    1930951,
+    1932275,
+    1933515,
+    1934723,
+    1936151,
+    1937511,
+    1938667,
+    1939899,
+    1941195,
+    1942747,
+    1944223,
+    1945339,
+    1946695,
+    1947879,
+    1949275,
+    1950747,
+    1952079,
+    1953575,
+    1954895,
+    1956139,
+    1957283,
+    1958339,
+    1960063,
+    1962439,
+    1964963,
+    1967331,
+    1969323,
+    1971095,
+    1972735,
+    1974199,
+    1975551,
+    1976387,
+    1976600,
+    1977315,
+    1978059,
+    1978905,
+    1979782,
+    1981032,
+    1981162,
+    1981277,
+    1981555,
+    1981758,
+    1982166,
+    1982622,
+    1983057,
+    1983492,
+    1983936,
+    1984713,
+    1985486,
+    1986114,
+    1986616,
+    1987492,
+    1987806,
+    1988253,
+    1991411,
+    1991701,
+    1991991,
+    1992271,
+    1992551,
+    1992883,
+    1993215,
+    1994083,
+    1994549,
+    1995030,
+    1995801,
+    1996565,
+    1998149,
+    2000845,
+    2004265,
+    2004845,
+    2005459,
+    2006090,
+    2006735,
+    2007353,
+    2007962,
+    2008568,
+    2009177,
+    2009469,
+    2009761,
+    2010053,
+    2010345,
+    2010905,
+    2011468,
+    2012029,
+    2012609,
+    2012965,
+    2013321,
+    2013633,
+    2013989,
+    2014935,
+    2015841,
+    2016747,
+    2017684,
+    2017684,
+    2017684,
+    2017684,
+    2022609,
+    2024298,
+    2025701,
+    2027295,
+    2028850,
+    2030350,
+    2032055,
+    2033101,
+    2034056,
+    2035066,
+    2036065,
+    2037084,
+    2038111,
+    2039179,
+    2040254,
+    2041374,
+    2042483,
+    2043575,
+    2044638,
+    2048128,
+    2051681,
+    2053167,
+    2056573,
+    2060251,
+    2063077,
+    2064067,
+    2065034,
+    2065997,
+    2066959,
+    2067996,
+    2070970,
+    2071557,
+    2071763,
+    2072332,
+    2073903,
+    2074761,
+    2093703,
+    2117566,
+    2120112,
+    2122908,
+    2125717,
+    2128562,
+    2131379,
+    2134322,
+    2137173,
+    2139866,
+    2142651,
+    2143412,
+    2143580,
+    2143747,
+    2143912,
+    2146257,
+    2149751,
+    2153253,
+    2156790,
+    2166187,
+    2170563,
+    2185462,
+    2188324,
+    2191314,
+    2194002,
+    2195645,
+    2197309,
+    2204789,
+    2207709,
+    2210670,
+    2212983,
+    2215311,
+    2217443,
+    2219582,
+    2221702,
+    2223788,
+    2226002,
+    2228153,
+    2232908,
+    2237708,
+    2242417,
+    2247017,
+    2249391,
+    2251868,
+    2254329,
+    2256539,
+    2258749,
+    2259196,
+    2259848,
+    2260988,
+    2261367,
+    2263482,
+    2264275,
+    2268189,
+    2271984,
+    2272235,
+    2272531,
+    2272691,
+    2273045,
+    2273480,
+    2273720,
+    2274029,
+    2274478,
+    2274906,
+    2275011,
+    2282128,
+    2282476,
+    2293147,
+    2302198,
+    2304438,
+    2306392,
+    2308343,
+    2310374,
+    2312889,
+    2315374,
+    2317665,
+    2319958,
+    2321571,
+    2323664,
+    2325576,
+    2327704,
+    2329600,
+    2332166,
+    2332350,
+    2333573,
+    2334046,
+    2334456,
+    2334794,
+    2336780,
+    2338591,
+    2340052,
+    2342557,
+    2345179,
+    2345860,
+    2346622,
+    2349995,
+    2358930,
+    2360326,
+    2361570,
+    2362826,
+    2365438,
+    2365875,
+    2374538,
+    2374837,
+    2375070,
+    2375180,
+    2375243,
+    2375355,
+    2375465,
+    2375528,
+    2375640,
+    2377373,
+    2377979,
+    2379932,
+    2382836,
+    2385187,
+    2387191,
+    2388317,
+    2390014,
+    2391101,
+    2391789,
+    2392468,
+    2393088,
+    2393796,
+    2394462,
+    2395144,
+    2395526,
+    2395923,
+    2420041,
+    2420041,
+    2420041,
+    2420041,
+    2420041,
+    2422390,
+    2424954,
+    2426719,
+    2428926,
+    2430604,
+    2433543,
+    2436002,
+    2438118,
+    2440267,
+    2443171,
+    2446297,
+    2448850,
+    2451408,
+    2454130,
+    2456316,
+    2458072,
+    2461249,
+    2464336,
+    2466610,
+    2469248,
+    2471418,
+    2473942,
+    2476849,
+    2479334,
+    2481604,
+    2484778,
+    2487909,
+    2491125,
+    2494407,
+    2496953,
+    2499418,
+    2501501,
+    2501772,
+    2502885,
+    2505194,
+    2507951,
+    2510968,
+    2513199,
+    2515753,
+    2518580,
+    2520840,
+    2523472,
+    2523619,
+    2526680,
+    2528313,
+    2531758,
+    2534554,
+    2536407,
+    2538210,
+    2539665,
+    2542263,
+    2544919,
+    2547654,
+    2550671,
+    2550671,
+    2550671,
+    2550801,
+    2552931,
+    2554845,
+    2555043,
+    2555188,
+    2555398,
+    2555604,
+    2555779,
+    2555983,
+    2556182,
+    2556335,
+    2556538,
+    2556739,
+    2567491,
+    2578243,
+    2588995,
+    2598281,
+};
+
+int32_t CONSTMEM _lumpsize[WADLUMPS] = {
+    10752,
+    8704,
+    4000,
+    20118,
+    15358,
+    8550,
+    0,
+    1380,
+    26600,
+    7776,
+    3736,
+    23424,
+    948,
+    6608,
+    2210,
+    904,
+    6922,
+    0,
+    2620,
+    57848,
+    15876,
+    7536,
+    46816,
+    1792,
+    12516,
+    5200,
+    5000,
+    11870,
+    0,
+    3800,
+    57456,
+    15912,
+    7568,
+    46240,
+    1844,
+    12880,
+    4602,
+    3917,
+    8894,
+    0,
+    2540,
+    46480,
+    12648,
+    6240,
+    37504,
+    1420,
+    9912,
+    3614,
+    2416,
+    7218,
+    0,
+    2930,
+    46200,
+    12636,
+    5968,
+    36512,
+    1536,
+    10724,
+    3718,
+    2557,
+    8032,
+    0,
+    4630,
+    75712,
+    20724,
+    9656,
+    59584,
+    2424,
+    16940,
+    6500,
+    7813,
+    15804,
+    0,
+    3580,
+    53648,
+    14676,
+    7168,
+    43872,
+    1868,
+    13048,
+    4420,
+    3613,
+    8846,
+    0,
+    1260,
+    18648,
+    6132,
+    2624,
+    18752,
+    708,
+    4928,
+    1924,
+    685,
+    19400,
+    0,
+    2370,
+    36568,
+    10824,
+    4648,
+    31296,
+    1152,
+    8036,
+    3822,
+    2702,
+    6780,
+    9234,
+    2804,
+    5342,
+    68168,
+    68168,
+    68168,
+    68168,
+    48,
+    32,
+    60,
+    60,
+    44,
+    60,
+    56,
+    52,
+    60,
+    52,
+    13128,
+    68,
+    64,
+    76,
+    72,
+    60,
+    72,
+    72,
+    72,
+    76,
+    72,
+    128,
+    320,
+    244,
+    336,
+    336,
+    316,
+    348,
+    340,
+    276,
+    348,
+    336,
+    328,
+    68,
+    64,
+    76,
+    72,
+    60,
+    72,
+    72,
+    72,
+    76,
+    72,
+    104,
+    104,
+    104,
+    120,
+    120,
+    120,
+    392,
+    328,
+    1648,
+    72,
+    100,
+    116,
+    128,
+    144,
+    132,
+    60,
+    120,
+    120,
+    96,
+    76,
+    60,
+    80,
+    56,
+    100,
+    132,
+    84,
+    140,
+    132,
+    116,
+    124,
+    132,
+    120,
+    140,
+    132,
+    84,
+    72,
+    80,
+    80,
+    80,
+    128,
+    156,
+    132,
+    140,
+    140,
+    132,
+    132,
+    128,
+    132,
+    136,
+    72,
+    120,
+    140,
+    120,
+    148,
+    136,
+    124,
+    128,
+    136,
+    140,
+    120,
+    120,
+    132,
+    108,
+    148,
+    160,
+    124,
+    128,
+    92,
+    100,
+    92,
+    96,
+    104,
+    72,
+    1408,
+    1408,
+    1408,
+    1408,
+    1480,
+    1480,
+    1480,
+    1480,
+    808,
+    808,
+    808,
+    884,
+    880,
+    844,
+    816,
+    824,
+    808,
+    808,
+    800,
+    884,
+    888,
+    844,
+    816,
+    824,
+    828,
+    824,
+    824,
+    896,
+    896,
+    844,
+    816,
+    824,
+    836,
+    840,
+    832,
+    944,
+    908,
+    844,
+    816,
+    824,
+    836,
+    844,
+    844,
+    984,
+    908,
+    844,
+    816,
+    824,
+    808,
+    836,
+    6772,
+    2312,
+    1856,
+    2220,
+    2128,
+    504,
+    504,
+    108,
+    140,
+    208,
+    140,
+    2180,
+    1408,
+    2448,
+    628,
+    728,
+    3404,
+    4908,
+    4220,
+    1784,
+    3232,
+    4248,
+    4320,
+    4396,
+    2452,
+    3632,
+    2636,
+    3192,
+    2164,
+    2364,
+    2332,
+    1692,
+    3920,
+    996,
+    800,
+    3300,
+    4268,
+    2852,
+    2796,
+    2796,
+    2520,
+    2976,
+    192,
+    192,
+    192,
+    44,
+    104,
+    44,
+    60,
+    60,
+    44,
+    104,
+    44,
+    68168,
+    144,
+    144,
+    144,
+    208,
+    208,
+    208,
+    208,
+    208,
+    208,
+    144,
+    144,
+    144,
+    144,
+    144,
+    144,
+    144,
+    144,
+    144,
+    208,
+    208,
+    208,
+    208,
+    208,
+    208,
+    416,
+    416,
+    416,
+    144,
+    144,
+    144,
+    1080,
+    1080,
+    644,
+    1084,
+    1184,
+    1844,
+    1156,
+    1076,
+    272,
+    880,
+    808,
+    860,
+    80,
+    264,
+    228,
+    136,
+    244,
+    236,
+    212,
+    244,
+    236,
+    188,
+    232,
+    232,
+    108,
+    1460,
+    1136,
+    1712,
+    3064,
+    3152,
+    3896,
+    2556,
+    4556,
+    3960,
+    3660,
+    2920,
+    3964,
+    1960,
+    3628,
+    4336,
+    3208,
+    3288,
+    4656,
+    2080,
+    4064,
+    2944,
+    3004,
+    3940,
+    2304,
+    2908,
+    752,
+    1984,
+    2416,
+    3508,
+    404,
+    512,
+    500,
+    480,
+    404,
+    512,
+    500,
+    480,
+    532,
+    904,
+    1592,
+    2036,
+    0,
+    8180,
+    8204,
+    2684,
+    2308,
+    6692,
+    6692,
+    7852,
+    7980,
+    2632,
+    3768,
+    3664,
+    3616,
+    4892,
+    1408,
+    320,
+    320,
+    1316,
+    1624,
+    2064,
+    76,
+    144,
+    256,
+    376,
+    76,
+    132,
+    216,
+    340,
+    316,
+    1884,
+    2360,
+    2228,
+    3788,
+    5976,
+    4260,
+    2184,
+    1696,
+    1396,
+    1020,
+    392,
+    152,
+    44,
+    88,
+    176,
+    260,
+    1396,
+    1052,
+    388,
+    144,
+    44,
+    244,
+    256,
+    628,
+    1236,
+    872,
+    460,
+    108,
+    1104,
+    1328,
+    1588,
+    1344,
+    944,
+    1092,
+    1332,
+    1588,
+    1232,
+    756,
+    1396,
+    1444,
+    1308,
+    1368,
+    3112,
+    2596,
+    4152,
+    6716,
+    5976,
+    6588,
+    1624,
+    3208,
+    4792,
+    4496,
+    264,
+    600,
+    892,
+    484,
+    264,
+    3400,
+    8860,
+    10368,
+    10668,
+    1156,
+    1668,
+    2000,
+    2384,
+    2388,
+    2160,
+    1640,
+    2080,
+    2040,
+    2164,
+    2056,
+    1848,
+    1996,
+    2172,
+    2288,
+    1988,
+    1640,
+    2080,
+    2144,
+    2176,
+    1832,
+    1848,
+    2144,
+    1920,
+    2232,
+    2028,
+    1844,
+    1816,
+    2336,
+    2216,
+    2148,
+    2124,
+    2560,
+    2144,
+    1976,
+    1964,
+    2660,
+    2456,
+    2172,
+    2012,
+    2436,
+    2088,
+    2036,
+    1936,
+    2528,
+    2292,
+    2088,
+    1972,
+    2172,
+    2000,
+    1560,
+    1696,
+    2156,
+    2108,
+    2340,
+    2248,
+    1900,
+    1908,
+    1836,
+    1728,
+    1632,
+    1564,
+    1144,
+    1048,
+    1208,
+    1600,
+    1420,
+    1304,
+    1228,
+    1152,
+    1612,
+    1528,
+    1148,
+    1060,
+    1212,
+    1528,
+    1652,
+    1320,
+    1012,
+    1148,
+    1680,
+    1260,
+    1284,
+    1252,
+    1176,
+    1588,
+    1476,
+    1380,
+    1180,
+    1164,
+    1328,
+    1644,
+    1700,
+    1380,
+    1112,
+    1452,
+    1144,
+    1328,
+    1336,
+    1404,
+    1592,
+    1504,
+    1300,
+    1292,
+    1232,
+    2212,
+    2548,
+    2852,
+    2576,
+    2008,
+    1824,
+    1456,
+    1240,
+    2288,
+    2180,
+    2456,
+    2184,
+    2148,
+    2792,
+    2412,
+    2000,
+    2156,
+    2532,
+    2288,
+    2480,
+    2400,
+    2024,
+    2148,
+    2788,
+    2380,
+    2020,
+    2224,
+    2532,
+    2792,
+    2036,
+    2508,
+    2732,
+    2540,
+    2124,
+    2380,
+    2984,
+    3068,
+    2604,
+    2316,
+    2536,
+    2544,
+    2468,
+    2112,
+    2592,
+    2400,
+    2724,
+    2308,
+    2216,
+    2216,
+    2332,
+    2200,
+    2352,
+    2692,
+    2372,
+    2508,
+    2324,
+    2376,
+    2200,
+    2272,
+    2436,
+    2692,
+    2576,
+    2504,
+    2032,
+    1760,
+    1784,
+    1784,
+    424,
+    576,
+    748,
+    508,
+    460,
+    568,
+    768,
+    520,
+    1020,
+    1308,
+    1776,
+    1420,
+    1332,
+    1424,
+    1388,
+    1220,
+    1452,
+    1288,
+    1300,
+    1388,
+    1312,
+    1432,
+    1436,
+    1304,
+    1352,
+    1344,
+    1440,
+    1400,
+    1228,
+    1300,
+    1348,
+    1276,
+    1368,
+    1600,
+    1420,
+    1172,
+    1280,
+    1412,
+    1648,
+    1496,
+    1120,
+    1492,
+    1316,
+    1484,
+    1496,
+    1396,
+    1636,
+    1428,
+    1532,
+    1412,
+    1048,
+    1052,
+    1060,
+    1668,
+    2304,
+    2432,
+    2304,
+    1968,
+    1748,
+    1604,
+    1384,
+    1364,
+    1392,
+    1316,
+    1408,
+    1352,
+    1220,
+    1416,
+    1260,
+    1284,
+    1356,
+    1300,
+    1404,
+    1412,
+    1304,
+    1336,
+    1336,
+    1428,
+    1372,
+    1208,
+    1292,
+    1312,
+    1248,
+    1356,
+    1584,
+    1420,
+    1156,
+    1248,
+    1416,
+    1644,
+    1480,
+    1112,
+    1484,
+    1288,
+    1424,
+    1472,
+    1384,
+    1604,
+    1276,
+    1224,
+    1128,
+    988,
+    1824,
+    2408,
+    2524,
+    2368,
+    1992,
+    1772,
+    1640,
+    1464,
+    1352,
+    1316,
+    1224,
+    1320,
+    1320,
+    1212,
+    1384,
+    1104,
+    1136,
+    1312,
+    1300,
+    1336,
+    1228,
+    1256,
+    1264,
+    1332,
+    1364,
+    1240,
+    1128,
+    1228,
+    1324,
+    1240,
+    1208,
+    1428,
+    1360,
+    1156,
+    1232,
+    1296,
+    1552,
+    1476,
+    1116,
+    1356,
+    1184,
+    1396,
+    1472,
+    1332,
+    1496,
+    1320,
+    1244,
+    1144,
+    1056,
+    1724,
+    2376,
+    2524,
+    2368,
+    1992,
+    1772,
+    1640,
+    1464,
+    1352,
+    836,
+    244,
+    1100,
+    904,
+    1124,
+    1124,
+    1524,
+    188,
+    216,
+    364,
+    340,
+    780,
+    656,
+    656,
+    656,
+    656,
+    944,
+    944,
+    832,
+    796,
+    1616,
+    704,
+    664,
+    4272,
+    332,
+    332,
+    332,
+    332,
+    332,
+    332,
+    1112,
+    604,
+    604,
+    944,
+    924,
+    1584,
+    2696,
+    3420,
+    1004,
+    1004,
+    1004,
+    1004,
+    724,
+    724,
+    724,
+    724,
+    292,
+    292,
+    292,
+    292,
+    724,
+    724,
+    724,
+    724,
+    356,
+    356,
+    356,
+    356,
+    1120,
+    1060,
+    1048,
+    1088,
+    0,
+    0,
+    0,
+    10056,
+    2520,
+    2520,
+    2520,
+    2520,
+    2520,
+    2520,
+    1304,
+    1304,
+    1304,
+    1304,
+    1304,
+    1304,
+    1304,
+    1304,
+    1304,
+    1304,
+    1304,
+    1304,
+    5192,
+    5192,
+    1952,
+    5192,
+    5192,
+    4680,
+    1304,
+    1304,
+    1304,
+    1304,
+    1304,
+    4168,
+    5192,
+    1304,
+    1304,
+    5192,
+    5192,
+    28080,
+    36960,
+    4680,
+    4680,
+    4680,
+    4680,
+    4680,
+    4680,
+    4680,
+    4680,
+    4680,
+    1096,
+    208,
+    208,
+    208,
+    8776,
+    8776,
+    8776,
+    8776,
+    17544,
+    8776,
+    17544,
+    3984,
+    3984,
+    3940,
+    2100,
+    2220,
+    14312,
+    4276,
+    4212,
+    4392,
+    4392,
+    4392,
+    4392,
+    4392,
+    4392,
+    4392,
+    4392,
+    8776,
+    8776,
+    8776,
+    8776,
+    4392,
+    4392,
+    4392,
+    4392,
+    4392,
+    1304,
+    8776,
+    8776,
+    1104,
+    8776,
+    1952,
+    10376,
+    10376,
+    552,
+    552,
+    552,
+    552,
+    552,
+    552,
+    552,
+    552,
+    808,
+    208,
+    17544,
+    1104,
+    17544,
+    17544,
+    3648,
+    3648,
+    3648,
+    3648,
+    3648,
+    4168,
+    4168,
+    4168,
+    4168,
+    4168,
+    4168,
+    4168,
+    4168,
+    4680,
+    2344,
+    4680,
+    2344,
+    2344,
+    2344,
+    4680,
+    4680,
+    4680,
+    4680,
+    4680,
+    4680,
+    4680,
+    10088,
+    17544,
+    5192,
+    1952,
+    1952,
+    5192,
+    1104,
+    17544,
+    552,
+    552,
+    144,
+    144,
+    144,
+    144,
+    144,
+    144,
+    2120,
+    1716,
+    3476,
+    3476,
+    3476,
+    3476,
+    3476,
+    3476,
+    1924,
+    1320,
+    1320,
+    1320,
+    1320,
+    1320,
+    1320,
+    800,
+    800,
+    35080,
+    0,
+    0,
+    0,
+    0,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    4096,
+    0,
+    0,
+    130,
+    2702,
+    3056,
+    232,
+    200,
+    259,
+    246,
+    224,
+    257,
+    246,
+    211,
+    249,
+    237,
+    10752,
+    10752,
+    10752,
+    10752,
+    10752,
+};
+
+uint32_t CONSTMEM _lumpname_high[WADLUMPS] = {
+    0x004c4150,
+    0x50414d52,
+    0x00004d4f,
+    0x00000031,
+    0x00000032,
+    0x00000033,
+    0x00000000,
+    0x00005347,
+    0x53464544,
+    0x53464544,
+    0x53455845,
+    0x00000000,
+    0x53524f54,
+    0x00000053,
+    0x0053524f,
+    0x00005443,
+    0x50414d4b,
+    0x00000000,
+    0x00005347,
+    0x53464544,
+    0x53464544,
+    0x53455845,
+    0x00000000,
+    0x53524f54,
+    0x00000053,
+    0x0053524f,
+    0x00005443,
+    0x50414d4b,
+    0x00000000,
+    0x00005347,
+    0x53464544,
+    0x53464544,
+    0x53455845,
+    0x00000000,
+    0x53524f54,
+    0x00000053,
+    0x0053524f,
+    0x00005443,
+    0x50414d4b,
+    0x00000000,
+    0x00005347,
+    0x53464544,
+    0x53464544,
+    0x53455845,
+    0x00000000,
+    0x53524f54,
+    0x00000053,
+    0x0053524f,
+    0x00005443,
+    0x50414d4b,
+    0x00000000,
+    0x00005347,
+    0x53464544,
+    0x53464544,
+    0x53455845,
+    0x00000000,
+    0x53524f54,
+    0x00000053,
+    0x0053524f,
+    0x00005443,
+    0x50414d4b,
+    0x00000000,
+    0x00005347,
+    0x53464544,
+    0x53464544,
+    0x53455845,
+    0x00000000,
+    0x53524f54,
+    0x00000053,
+    0x0053524f,
+    0x00005443,
+    0x50414d4b,
+    0x00000000,
+    0x00005347,
+    0x53464544,
+    0x53464544,
+    0x53455845,
+    0x00000000,
+    0x53524f54,
+    0x00000053,
+    0x0053524f,
+    0x00005443,
+    0x50414d4b,
+    0x00000000,
+    0x00005347,
+    0x53464544,
+    0x53464544,
+    0x53455845,
+    0x00000000,
+    0x53524f54,
+    0x00000053,
+    0x0053524f,
+    0x00005443,
+    0x50414d4b,
+    0x00000000,
+    0x00005347,
+    0x53464544,
+    0x53464544,
+    0x53455845,
+    0x00000000,
+    0x53524f54,
+    0x00000053,
+    0x0053524f,
+    0x00005443,
+    0x50414d4b,
+    0x31455255,
+    0x00005345,
+    0x00005355,
+    0x00000031,
+    0x00000032,
+    0x00005449,
+    0x43495045,
+    0x00304d55,
+    0x00314d55,
+    0x00324d55,
+    0x00334d55,
+    0x00344d55,
+    0x00354d55,
+    0x00364d55,
+    0x00374d55,
+    0x00384d55,
+    0x00394d55,
+    0x00000052,
+    0x00304d55,
+    0x00314d55,
+    0x00324d55,
+    0x00334d55,
+    0x00344d55,
+    0x00354d55,
+    0x00364d55,
+    0x00374d55,
+    0x00384d55,
+    0x00394d55,
+    0x53554e49,
+    0x00304d55,
+    0x00314d55,
+    0x00324d55,
+    0x00334d55,
+    0x00344d55,
+    0x00354d55,
+    0x00364d55,
+    0x00374d55,
+    0x00384d55,
+    0x00394d55,
+    0x544e4352,
+    0x304d554e,
+    0x314d554e,
+    0x324d554e,
+    0x334d554e,
+    0x344d554e,
+    0x354d554e,
+    0x364d554e,
+    0x374d554e,
+    0x384d554e,
+    0x394d554e,
+    0x00305359,
+    0x00315359,
+    0x00325359,
+    0x00335359,
+    0x00345359,
+    0x00355359,
+    0x00004b53,
+    0x004d4f52,
+    0x0000534d,
+    0x3333304e,
+    0x3433304e,
+    0x3533304e,
+    0x3633304e,
+    0x3733304e,
+    0x3833304e,
+    0x3933304e,
+    0x3034304e,
+    0x3134304e,
+    0x3234304e,
+    0x3334304e,
+    0x3434304e,
+    0x3534304e,
+    0x3634304e,
+    0x3734304e,
+    0x3834304e,
+    0x3934304e,
+    0x3035304e,
+    0x3135304e,
+    0x3235304e,
+    0x3335304e,
+    0x3435304e,
+    0x3535304e,
+    0x3635304e,
+    0x3735304e,
+    0x3835304e,
+    0x3935304e,
+    0x3036304e,
+    0x3136304e,
+    0x3236304e,
+    0x3336304e,
+    0x3436304e,
+    0x3536304e,
+    0x3636304e,
+    0x3736304e,
+    0x3836304e,
+    0x3936304e,
+    0x3037304e,
+    0x3137304e,
+    0x3237304e,
+    0x3337304e,
+    0x3437304e,
+    0x3537304e,
+    0x3637304e,
+    0x3737304e,
+    0x3837304e,
+    0x3937304e,
+    0x3038304e,
+    0x3138304e,
+    0x3238304e,
+    0x3338304e,
+    0x3438304e,
+    0x3538304e,
+    0x3638304e,
+    0x3738304e,
+    0x3838304e,
+    0x3938304e,
+    0x3039304e,
+    0x3139304e,
+    0x3239304e,
+    0x3339304e,
+    0x3439304e,
+    0x3539304e,
+    0x3132314e,
+    0x00000031,
+    0x00000030,
+    0x00000032,
+    0x00000033,
+    0x00000031,
+    0x00000030,
+    0x00000032,
+    0x00000033,
+    0x00313054,
+    0x00303054,
+    0x00323054,
+    0x0030304c,
+    0x00303052,
+    0x30484355,
+    0x00304c56,
+    0x304c4c49,
+    0x00313154,
+    0x00303154,
+    0x00323154,
+    0x0030314c,
+    0x00303152,
+    0x31484355,
+    0x00314c56,
+    0x314c4c49,
+    0x00313254,
+    0x00303254,
+    0x00323254,
+    0x0030324c,
+    0x00303252,
+    0x32484355,
+    0x00324c56,
+    0x324c4c49,
+    0x00313354,
+    0x00303354,
+    0x00323354,
+    0x0030334c,
+    0x00303352,
+    0x33484355,
+    0x00334c56,
+    0x334c4c49,
+    0x00313454,
+    0x00303454,
+    0x00323454,
+    0x0030344c,
+    0x00303452,
+    0x34484355,
+    0x00344c56,
+    0x344c4c49,
+    0x0030444f,
+    0x30444145,
+    0x00004d4f,
+    0x53494854,
+    0x4e4f4954,
+    0x00475449,
+    0x00454d41,
+    0x314c4c55,
+    0x324c4c55,
+    0x4f4d5245,
+    0x524d5245,
+    0x4d4d5245,
+    0x4c4d5245,
+    0x4d414744,
+    0x00455355,
+    0x00475353,
+    0x004e4f47,
+    0x46464f47,
+    0x444f5349,
+    0x00003149,
+    0x00003249,
+    0x00003349,
+    0x00005452,
+    0x004c4c49,
+    0x00484755,
+    0x004c4c49,
+    0x00004757,
+    0x00415254,
+    0x00455241,
+    0x00004c4f,
+    0x4c545454,
+    0x00474556,
+    0x00474441,
+    0x00005053,
+    0x00534e45,
+    0x48474948,
+    0x00574f4c,
+    0x4c494154,
+    0x54504f53,
+    0x5a534e52,
+    0x004c5454,
+    0x004c5454,
+    0x4c4f5658,
+    0x4c4f5653,
+    0x5446454c,
+    0x52544e43,
+    0x54484752,
+    0x004c545f,
+    0x0000545f,
+    0x0052545f,
+    0x00004c5f,
+    0x0000525f,
+    0x004c425f,
+    0x0000425f,
+    0x0052425f,
+    0x00003050,
+    0x30303930,
+    0x31303930,
+    0x32303930,
+    0x30303830,
+    0x31303830,
+    0x32303830,
+    0x30303730,
+    0x31303730,
+    0x32303730,
+    0x30303630,
+    0x31303630,
+    0x32303630,
+    0x30303530,
+    0x31303530,
+    0x32303530,
+    0x30303430,
+    0x31303430,
+    0x32303430,
+    0x30303330,
+    0x31303330,
+    0x32303330,
+    0x30303230,
+    0x31303230,
+    0x32303230,
+    0x30303130,
+    0x31303130,
+    0x32303130,
+    0x30303030,
+    0x31303030,
+    0x32303030,
+    0x00003048,
+    0x00003148,
+    0x0054414c,
+    0x00004b54,
+    0x00004954,
+    0x00000000,
+    0x00005454,
+    0x00005354,
+    0x00004654,
+    0x0000454d,
+    0x00000052,
+    0x00524154,
+    0x0053554e,
+    0x0000544e,
+    0x0000304d,
+    0x0000314d,
+    0x0000324d,
+    0x0000334d,
+    0x0000344d,
+    0x0000354d,
+    0x0000364d,
+    0x0000374d,
+    0x0000384d,
+    0x0000394d,
+    0x004e4f4c,
+    0x00534b43,
+    0x00005347,
+    0x00003030,
+    0x00003130,
+    0x00003230,
+    0x00003330,
+    0x00003430,
+    0x00003530,
+    0x00003630,
+    0x00003730,
+    0x00003830,
+    0x00003131,
+    0x00003231,
+    0x00003431,
+    0x00003531,
+    0x00003631,
+    0x00003731,
+    0x00003831,
+    0x00003032,
+    0x00003132,
+    0x00003232,
+    0x00003332,
+    0x00003432,
+    0x00003532,
+    0x00003632,
+    0x00003732,
+    0x00003832,
+    0x00003331,
+    0x00003031,
+    0x00000000,
+    0x00000000,
+    0x00000000,
+    0x00000000,
+    0x00000031,
+    0x00000032,
+    0x00000033,
+    0x00000034,
+    0x0053524c,
+    0x00534d54,
+    0x00325452,
+    0x00524554,
+    0x00545241,
+    0x00003041,
+    0x00003042,
+    0x00003041,
+    0x00003042,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003044,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003044,
+    0x00003045,
+    0x00003041,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003044,
+    0x00003045,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003044,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003044,
+    0x00003045,
+    0x00003042,
+    0x00003043,
+    0x00003044,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003044,
+    0x00003045,
+    0x00003046,
+    0x00003047,
+    0x00003048,
+    0x00003049,
+    0x0000304a,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003044,
+    0x00003045,
+    0x00003041,
+    0x00003042,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003044,
+    0x00003045,
+    0x00003141,
+    0x32413841,
+    0x33413741,
+    0x34413641,
+    0x00003541,
+    0x00003142,
+    0x32423842,
+    0x33423742,
+    0x34423642,
+    0x00003542,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003044,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003044,
+    0x00003041,
+    0x00003042,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003044,
+    0x00003141,
+    0x32413841,
+    0x33413741,
+    0x34413641,
+    0x00003541,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003044,
+    0x00003041,
+    0x00003042,
+    0x00003141,
+    0x38413241,
+    0x37413341,
+    0x36413441,
+    0x00003541,
+    0x00003142,
+    0x38423242,
+    0x37423342,
+    0x36423442,
+    0x00003542,
+    0x00003143,
+    0x38433243,
+    0x37433343,
+    0x36433443,
+    0x00003543,
+    0x00003144,
+    0x38443244,
+    0x37443344,
+    0x36443444,
+    0x00003544,
+    0x00003145,
+    0x00003245,
+    0x00003345,
+    0x00003445,
+    0x00003545,
+    0x00003645,
+    0x00003745,
+    0x00003845,
+    0x00003146,
+    0x00003246,
+    0x00003346,
+    0x00003446,
+    0x00003546,
+    0x00003646,
+    0x00003746,
+    0x00003846,
+    0x00003147,
+    0x00003247,
+    0x00003347,
+    0x00003447,
+    0x00003547,
+    0x00003647,
+    0x00003747,
+    0x00003847,
+    0x00003148,
+    0x00003248,
+    0x00003348,
+    0x00003448,
+    0x00003548,
+    0x00003648,
+    0x00003748,
+    0x00003848,
+    0x00003049,
+    0x0000304a,
+    0x0000304b,
+    0x0000304c,
+    0x0000304d,
+    0x0000304e,
+    0x00003141,
+    0x38413241,
+    0x37413341,
+    0x36413441,
+    0x00003541,
+    0x00003142,
+    0x38423242,
+    0x37423342,
+    0x36423442,
+    0x00003542,
+    0x00003143,
+    0x38433243,
+    0x37433343,
+    0x36433443,
+    0x00003543,
+    0x00003144,
+    0x38443244,
+    0x37443344,
+    0x36443444,
+    0x00003544,
+    0x00003145,
+    0x38453245,
+    0x37453345,
+    0x36453445,
+    0x00003545,
+    0x00003146,
+    0x38463246,
+    0x37463346,
+    0x36463446,
+    0x00003546,
+    0x00003147,
+    0x38473247,
+    0x37473347,
+    0x36473447,
+    0x00003547,
+    0x00003148,
+    0x38483248,
+    0x37483348,
+    0x36483448,
+    0x00003548,
+    0x00003049,
+    0x0000304a,
+    0x0000304b,
+    0x0000304c,
+    0x0000304d,
+    0x0000304e,
+    0x0000304f,
+    0x00003050,
+    0x00003051,
+    0x00003052,
+    0x00003053,
+    0x00003054,
+    0x00003055,
+    0x00003141,
+    0x38413241,
+    0x37413341,
+    0x36413441,
+    0x00003541,
+    0x00003142,
+    0x38423242,
+    0x37423342,
+    0x36423442,
+    0x00003542,
+    0x00003143,
+    0x38433243,
+    0x37433343,
+    0x36433443,
+    0x00003543,
+    0x00003144,
+    0x38443244,
+    0x37443344,
+    0x36443444,
+    0x00003544,
+    0x00003145,
+    0x00003245,
+    0x00003345,
+    0x00003445,
+    0x00003545,
+    0x00003645,
+    0x00003745,
+    0x00003845,
+    0x00003146,
+    0x00003246,
+    0x00003346,
+    0x00003446,
+    0x00003546,
+    0x00003646,
+    0x00003746,
+    0x00003846,
+    0x00003147,
+    0x00003247,
+    0x00003347,
+    0x00003447,
+    0x00003547,
+    0x00003647,
+    0x00003747,
+    0x00003847,
+    0x00003148,
+    0x00003248,
+    0x00003348,
+    0x00003448,
+    0x00003548,
+    0x00003648,
+    0x00003748,
+    0x00003848,
+    0x00003049,
+    0x0000304a,
+    0x0000304b,
+    0x0000304c,
+    0x0000304d,
+    0x0000304e,
+    0x0000304f,
+    0x35413141,
+    0x38413241,
+    0x37413341,
+    0x36413441,
+    0x35423142,
+    0x38423242,
+    0x37423342,
+    0x36423442,
+    0x00003043,
+    0x00003044,
+    0x00003045,
+    0x00003141,
+    0x38413241,
+    0x37413341,
+    0x36413441,
+    0x00003541,
+    0x00003142,
+    0x38423242,
+    0x37423342,
+    0x36423442,
+    0x00003542,
+    0x00003143,
+    0x38433243,
+    0x37433343,
+    0x36433443,
+    0x00003543,
+    0x00003144,
+    0x38443244,
+    0x37443344,
+    0x36443444,
+    0x00003544,
+    0x00003145,
+    0x38453245,
+    0x37453345,
+    0x36453445,
+    0x00003545,
+    0x00003146,
+    0x38463246,
+    0x37463346,
+    0x36463446,
+    0x00003546,
+    0x00003147,
+    0x38473247,
+    0x37473347,
+    0x36473447,
+    0x00003547,
+    0x00003048,
+    0x00003049,
+    0x0000304a,
+    0x0000304b,
+    0x0000304c,
+    0x0000304d,
+    0x0000304e,
+    0x0000304f,
+    0x00003050,
+    0x00003051,
+    0x00003052,
+    0x00003053,
+    0x00003054,
+    0x00003055,
+    0x00003056,
+    0x00003057,
+    0x00003141,
+    0x38413241,
+    0x37413341,
+    0x36413441,
+    0x00003541,
+    0x00003142,
+    0x38423242,
+    0x37423342,
+    0x36423442,
+    0x00003542,
+    0x00003143,
+    0x38433243,
+    0x37433343,
+    0x36433443,
+    0x00003543,
+    0x00003144,
+    0x38443244,
+    0x37443344,
+    0x36443444,
+    0x00003544,
+    0x00003145,
+    0x38453245,
+    0x37453345,
+    0x36453445,
+    0x00003545,
+    0x00003146,
+    0x38463246,
+    0x37463346,
+    0x36463446,
+    0x00003546,
+    0x00003147,
+    0x38473247,
+    0x37473347,
+    0x36473447,
+    0x00003547,
+    0x00003048,
+    0x00003049,
+    0x0000304a,
+    0x0000304b,
+    0x0000304c,
+    0x0000304d,
+    0x0000304e,
+    0x0000304f,
+    0x00003050,
+    0x00003051,
+    0x00003052,
+    0x00003053,
+    0x00003054,
+    0x00003055,
+    0x00003141,
+    0x38413241,
+    0x37413341,
+    0x36413441,
+    0x00003541,
+    0x00003142,
+    0x38423242,
+    0x37423342,
+    0x36423442,
+    0x00003542,
+    0x00003143,
+    0x38433243,
+    0x37433343,
+    0x36433443,
+    0x00003543,
+    0x00003144,
+    0x38443244,
+    0x37443344,
+    0x36443444,
+    0x00003544,
+    0x00003145,
+    0x38453245,
+    0x37453345,
+    0x36453445,
+    0x00003545,
+    0x00003146,
+    0x38463246,
+    0x37463346,
+    0x36463446,
+    0x00003546,
+    0x00003147,
+    0x38473247,
+    0x37473347,
+    0x36473447,
+    0x00003547,
+    0x00003048,
+    0x00003049,
+    0x0000304a,
+    0x0000304b,
+    0x0000304c,
+    0x0000304d,
+    0x0000304e,
+    0x0000304f,
+    0x00003050,
+    0x00003051,
+    0x00003052,
+    0x00003053,
+    0x00003054,
+    0x00003055,
+    0x00003041,
+    0x00003041,
+    0x00003041,
+    0x00003041,
+    0x00003041,
+    0x00003041,
+    0x00003041,
+    0x00003041,
+    0x00003041,
+    0x00003041,
+    0x00003041,
+    0x00003041,
+    0x00003041,
+    0x00003042,
+    0x00003041,
+    0x00003042,
+    0x00003041,
+    0x00003042,
+    0x00003041,
+    0x00003041,
+    0x00003041,
+    0x00003041,
+    0x00003041,
+    0x00003041,
+    0x00003041,
+    0x00003042,
+    0x00003041,
+    0x00003042,
+    0x00003041,
+    0x00003042,
+    0x00003041,
+    0x00003041,
+    0x00003042,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003044,
+    0x00003045,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003044,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003044,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003044,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003044,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003044,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003044,
+    0x00000044,
+    0x00545241,
+    0x54524154,
+    0x315f3030,
+    0x325f3030,
+    0x335f3030,
+    0x355f3030,
+    0x365f3030,
+    0x375f3030,
+    0x385f3030,
+    0x315f3130,
+    0x325f3130,
+    0x335f3130,
+    0x345f3130,
+    0x355f3130,
+    0x365f3130,
+    0x375f3130,
+    0x385f3130,
+    0x395f3130,
+    0x415f3130,
+    0x425f3130,
+    0x435f3130,
+    0x315f3230,
+    0x325f3230,
+    0x335f3230,
+    0x315f3330,
+    0x345f3330,
+    0x375f3330,
+    0x325f3430,
+    0x335f3430,
+    0x345f3430,
+    0x355f3430,
+    0x375f3430,
+    0x325f3530,
+    0x00000031,
+    0x00000038,
+    0x00000041,
+    0x00000034,
+    0x00000035,
+    0x00000031,
+    0x315f3432,
+    0x00000035,
+    0x00000036,
+    0x00000037,
+    0x00000038,
+    0x00000031,
+    0x00000031,
+    0x00000034,
+    0x00000035,
+    0x00000037,
+    0x00000038,
+    0x00003733,
+    0x00003833,
+    0x00003933,
+    0x315f3735,
+    0x325f3735,
+    0x335f3735,
+    0x345f3735,
+    0x315f3236,
+    0x325f3236,
+    0x00000031,
+    0x0000325f,
+    0x0000335f,
+    0x0000315f,
+    0x0000325f,
+    0x0000335f,
+    0x0000315f,
+    0x0000325f,
+    0x0000335f,
+    0x0000315f,
+    0x0000325f,
+    0x0000345f,
+    0x0000355f,
+    0x0000315f,
+    0x0000325f,
+    0x0000345f,
+    0x0000355f,
+    0x0000315f,
+    0x0000325f,
+    0x0000335f,
+    0x0000345f,
+    0x0000345f,
+    0x0000355f,
+    0x0000365f,
+    0x0000375f,
+    0x0000375f,
+    0x00000035,
+    0x00315f38,
+    0x00325f38,
+    0x315f3832,
+    0x315f3832,
+    0x3254524f,
+    0x00315f32,
+    0x00325f32,
+    0x00003330,
+    0x00003430,
+    0x00003530,
+    0x00003630,
+    0x00003730,
+    0x00003830,
+    0x00003930,
+    0x00003031,
+    0x00000031,
+    0x00000032,
+    0x00315f32,
+    0x325f314c,
+    0x00000031,
+    0x00000032,
+    0x315f3130,
+    0x355f3130,
+    0x365f3130,
+    0x345f4231,
+    0x365f4331,
+    0x315f3230,
+    0x325f3230,
+    0x335f3230,
+    0x345f3230,
+    0x355f3230,
+    0x365f3230,
+    0x375f3230,
+    0x385f3230,
+    0x315f3330,
+    0x345f3330,
+    0x355f3330,
+    0x365f3330,
+    0x375f3330,
+    0x385f3330,
+    0x395f3330,
+    0x315f3430,
+    0x325f3430,
+    0x355f3430,
+    0x365f3430,
+    0x375f3430,
+    0x385f3430,
+    0x00315f32,
+    0x00345f32,
+    0x00355f32,
+    0x00345f33,
+    0x00355f33,
+    0x00365f33,
+    0x4b415254,
+    0x00315f39,
+    0x00003041,
+    0x00003042,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00003041,
+    0x00003042,
+    0x00003043,
+    0x00454744,
+    0x00000050,
+    0x0000324e,
+    0x0000334e,
+    0x0000344e,
+    0x0000354e,
+    0x0000364e,
+    0x0000384e,
+    0x00003041,
+    0x00000030,
+    0x00000031,
+    0x00000030,
+    0x00000031,
+    0x00000030,
+    0x00000031,
+    0x00000030,
+    0x00000031,
+    0x00000000,
+    0x0000444e,
+    0x00000044,
+    0x00545241,
+    0x54524154,
+    0x315f3052,
+    0x335f3052,
+    0x365f3052,
+    0x315f3152,
+    0x375f3152,
+    0x335f3352,
+    0x315f3452,
+    0x355f3452,
+    0x365f3452,
+    0x385f3452,
+    0x315f3552,
+    0x325f3552,
+    0x335f3552,
+    0x345f3552,
+    0x00000031,
+    0x00000032,
+    0x315f3652,
+    0x325f3652,
+    0x315f3645,
+    0x345f3645,
+    0x355f3645,
+    0x365f3645,
+    0x315f3752,
+    0x325f3752,
+    0x00315f38,
+    0x0000315f,
+    0x0000325f,
+    0x0000335f,
+    0x0000345f,
+    0x00315f33,
+    0x00325f33,
+    0x00355f33,
+    0x00325f34,
+    0x00335f34,
+    0x00315f35,
+    0x00325f35,
+    0x00000031,
+    0x00000032,
+    0x00000035,
+    0x00003031,
+    0x00003431,
+    0x00003831,
+    0x00003032,
+    0x00003232,
+    0x00003332,
+    0x00345f35,
+    0x00355f35,
+    0x00315f31,
+    0x00355f31,
+    0x00375f31,
+    0x00314547,
+    0x00324547,
+    0x00334547,
+    0x00003159,
+    0x0000444e,
+    0x00000044,
+    0x00535449,
+    0x00004e55,
+    0x00414d4d,
+    0x304d554e,
+    0x314d554e,
+    0x324d554e,
+    0x334d554e,
+    0x344d554e,
+    0x354d554e,
+    0x364d554e,
+    0x374d554e,
+    0x384d554e,
+    0x394d554e,
+    0x314c4150,
+    0x324c4150,
+    0x334c4150,
+    0x344c4150,
+    0x354c4150,
+};
+
+uint32_t CONSTMEM _lumpname_low[WADLUMPS] = {
+    0x59414c50,
+    0x4f4c4f43,
+    0x4f444e45,
+    0x4f4d4544,
+    0x4f4d4544,
+    0x4f4d4544,
+    0x314d3145,
+    0x4e494854,
+    0x454e494c,
+    0x45444953,
+    0x54524556,
+    0x53474553,
+    0x43455353,
+    0x45444f4e,
+    0x54434553,
+    0x454a4552,
+    0x434f4c42,
+    0x324d3145,
+    0x4e494854,
+    0x454e494c,
+    0x45444953,
+    0x54524556,
+    0x53474553,
+    0x43455353,
+    0x45444f4e,
+    0x54434553,
+    0x454a4552,
+    0x434f4c42,
+    0x334d3145,
+    0x4e494854,
+    0x454e494c,
+    0x45444953,
+    0x54524556,
+    0x53474553,
+    0x43455353,
+    0x45444f4e,
+    0x54434553,
+    0x454a4552,
+    0x434f4c42,
+    0x344d3145,
+    0x4e494854,
+    0x454e494c,
+    0x45444953,
+    0x54524556,
+    0x53474553,
+    0x43455353,
+    0x45444f4e,
+    0x54434553,
+    0x454a4552,
+    0x434f4c42,
+    0x354d3145,
+    0x4e494854,
+    0x454e494c,
+    0x45444953,
+    0x54524556,
+    0x53474553,
+    0x43455353,
+    0x45444f4e,
+    0x54434553,
+    0x454a4552,
+    0x434f4c42,
+    0x364d3145,
+    0x4e494854,
+    0x454e494c,
+    0x45444953,
+    0x54524556,
+    0x53474553,
+    0x43455353,
+    0x45444f4e,
+    0x54434553,
+    0x454a4552,
+    0x434f4c42,
+    0x374d3145,
+    0x4e494854,
+    0x454e494c,
+    0x45444953,
+    0x54524556,
+    0x53474553,
+    0x43455353,
+    0x45444f4e,
+    0x54434553,
+    0x454a4552,
+    0x434f4c42,
+    0x384d3145,
+    0x4e494854,
+    0x454e494c,
+    0x45444953,
+    0x54524556,
+    0x53474553,
+    0x43455353,
+    0x45444f4e,
+    0x54434553,
+    0x454a4552,
+    0x434f4c42,
+    0x394d3145,
+    0x4e494854,
+    0x454e494c,
+    0x45444953,
+    0x54524556,
+    0x53474553,
+    0x43455353,
+    0x45444f4e,
+    0x54434553,
+    0x454a4552,
+    0x434f4c42,
+    0x54584554,
+    0x4d414e50,
+    0x47584d44,
+    0x504c4548,
+    0x504c4548,
+    0x44455243,
+    0x4c544954,
+    0x4e4d4d41,
+    0x4e4d4d41,
+    0x4e4d4d41,
+    0x4e4d4d41,
+    0x4e4d4d41,
+    0x4e4d4d41,
+    0x4e4d4d41,
+    0x4e4d4d41,
+    0x4e4d4d41,
+    0x4e4d4d41,
+    0x41425453,
+    0x4e475453,
+    0x4e475453,
+    0x4e475453,
+    0x4e475453,
+    0x4e475453,
+    0x4e475453,
+    0x4e475453,
+    0x4e475453,
+    0x4e475453,
+    0x4e475453,
+    0x4d545453,
+    0x4e545453,
+    0x4e545453,
+    0x4e545453,
+    0x4e545453,
+    0x4e545453,
+    0x4e545453,
+    0x4e545453,
+    0x4e545453,
+    0x4e545453,
+    0x4e545453,
+    0x50545453,
+    0x53595453,
+    0x53595453,
+    0x53595453,
+    0x53595453,
+    0x53595453,
+    0x53595453,
+    0x53595453,
+    0x53595453,
+    0x53595453,
+    0x53595453,
+    0x454b5453,
+    0x454b5453,
+    0x454b5453,
+    0x454b5453,
+    0x454b5453,
+    0x454b5453,
+    0x49445453,
+    0x44435453,
+    0x52415453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x46435453,
+    0x42465453,
+    0x42465453,
+    0x42465453,
+    0x42465453,
+    0x42505453,
+    0x42505453,
+    0x42505453,
+    0x42505453,
+    0x53465453,
+    0x53465453,
+    0x53465453,
+    0x54465453,
+    0x54465453,
+    0x4f465453,
+    0x45465453,
+    0x4b465453,
+    0x53465453,
+    0x53465453,
+    0x53465453,
+    0x54465453,
+    0x54465453,
+    0x4f465453,
+    0x45465453,
+    0x4b465453,
+    0x53465453,
+    0x53465453,
+    0x53465453,
+    0x54465453,
+    0x54465453,
+    0x4f465453,
+    0x45465453,
+    0x4b465453,
+    0x53465453,
+    0x53465453,
+    0x53465453,
+    0x54465453,
+    0x54465453,
+    0x4f465453,
+    0x45465453,
+    0x4b465453,
+    0x53465453,
+    0x53465453,
+    0x53465453,
+    0x54465453,
+    0x54465453,
+    0x4f465453,
+    0x45465453,
+    0x4b465453,
+    0x47465453,
+    0x44465453,
+    0x4f445f4d,
+    0x44525f4d,
+    0x504f5f4d,
+    0x55515f4d,
+    0x474e5f4d,
+    0x4b535f4d,
+    0x4b535f4d,
+    0x48545f4d,
+    0x48545f4d,
+    0x48545f4d,
+    0x48545f4d,
+    0x4e455f4d,
+    0x41505f4d,
+    0x454d5f4d,
+    0x534d5f4d,
+    0x534d5f4d,
+    0x50455f4d,
+    0x50455f4d,
+    0x50455f4d,
+    0x50455f4d,
+    0x55485f4d,
+    0x4b4a5f4d,
+    0x4f525f4d,
+    0x4b535f4d,
+    0x454e5f4d,
+    0x4c555f4d,
+    0x4d4e5f4d,
+    0x56535f4d,
+    0x504f5f4d,
+    0x41535f4d,
+    0x4f4c5f4d,
+    0x49445f4d,
+    0x534d5f4d,
+    0x44475f4d,
+    0x44475f4d,
+    0x45445f4d,
+    0x49445f4d,
+    0x43535f4d,
+    0x47535f4d,
+    0x474c5f4d,
+    0x46535f4d,
+    0x554d5f4d,
+    0x534c5f4d,
+    0x534c5f4d,
+    0x534c5f4d,
+    0x52445242,
+    0x52445242,
+    0x52445242,
+    0x52445242,
+    0x52445242,
+    0x52445242,
+    0x52445242,
+    0x52445242,
+    0x414d4957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x30414957,
+    0x52554957,
+    0x52554957,
+    0x50534957,
+    0x534f4957,
+    0x534f4957,
+    0x00464957,
+    0x534d4957,
+    0x534f4957,
+    0x534f4957,
+    0x49544957,
+    0x41504957,
+    0x534d4957,
+    0x494d4957,
+    0x43504957,
+    0x554e4957,
+    0x554e4957,
+    0x554e4957,
+    0x554e4957,
+    0x554e4957,
+    0x554e4957,
+    0x554e4957,
+    0x554e4957,
+    0x554e4957,
+    0x554e4957,
+    0x4f434957,
+    0x55534957,
+    0x52464957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x564c4957,
+    0x31504957,
+    0x32504957,
+    0x33504957,
+    0x34504957,
+    0x50424957,
+    0x50424957,
+    0x50424957,
+    0x50424957,
+    0x494b4957,
+    0x43564957,
+    0x43534957,
+    0x4e454957,
+    0x54535f53,
+    0x47474843,
+    0x47474843,
+    0x46474843,
+    0x46474843,
+    0x47574153,
+    0x47574153,
+    0x47574153,
+    0x47574153,
+    0x47534950,
+    0x47534950,
+    0x47534950,
+    0x47534950,
+    0x47534950,
+    0x46534950,
+    0x314c4142,
+    0x314c4142,
+    0x314c4142,
+    0x314c4142,
+    0x314c4142,
+    0x46465550,
+    0x46465550,
+    0x46465550,
+    0x46465550,
+    0x44554c42,
+    0x44554c42,
+    0x44554c42,
+    0x324c4142,
+    0x324c4142,
+    0x324c4142,
+    0x324c4142,
+    0x324c4142,
+    0x4c53494d,
+    0x4c53494d,
+    0x4c53494d,
+    0x474f4654,
+    0x474f4654,
+    0x474f4654,
+    0x474f4654,
+    0x474f4654,
+    0x474f4654,
+    0x474f4654,
+    0x474f4654,
+    0x474f4654,
+    0x474f4654,
+    0x474f4649,
+    0x474f4649,
+    0x474f4649,
+    0x474f4649,
+    0x474f4649,
+    0x534c5041,
+    0x534c5041,
+    0x58425041,
+    0x58425041,
+    0x58425041,
+    0x58425041,
+    0x58425041,
+    0x464e414d,
+    0x464e414d,
+    0x464e414d,
+    0x464e414d,
+    0x464e414d,
+    0x464e414d,
+    0x464e414d,
+    0x464e414d,
+    0x464e414d,
+    0x464e414d,
+    0x46534f42,
+    0x46534f42,
+    0x46534f42,
+    0x46534f42,
+    0x474e5550,
+    0x474e5550,
+    0x474e5550,
+    0x474e5550,
+    0x4753494d,
+    0x4753494d,
+    0x4653494d,
+    0x4653494d,
+    0x4653494d,
+    0x4653494d,
+    0x4c53494d,
+    0x4c53494d,
+    0x4c53494d,
+    0x4c53494d,
+    0x4c53494d,
+    0x47544853,
+    0x47544853,
+    0x47544853,
+    0x47544853,
+    0x46544853,
+    0x46544853,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x47524153,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x4f4f5254,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x53534f42,
+    0x374c4142,
+    0x374c4142,
+    0x374c4142,
+    0x374c4142,
+    0x374c4142,
+    0x374c4142,
+    0x374c4142,
+    0x374c4142,
+    0x374c4142,
+    0x374c4142,
+    0x374c4142,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x53534f50,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x534f5053,
+    0x354c4f50,
+    0x444e4143,
+    0x41524243,
+    0x544f4853,
+    0x4e55474d,
+    0x4e55414c,
+    0x57415343,
+    0x50494c43,
+    0x4c454853,
+    0x4b434f52,
+    0x4d495453,
+    0x4944454d,
+    0x314d5241,
+    0x314d5241,
+    0x324d5241,
+    0x324d5241,
+    0x31524142,
+    0x31524142,
+    0x554c4f43,
+    0x4b415042,
+    0x4b4f5242,
+    0x4f4d4d41,
+    0x584f4253,
+    0x43454c45,
+    0x59454b42,
+    0x59454b42,
+    0x59454b59,
+    0x59454b59,
+    0x59454b52,
+    0x59454b52,
+    0x54495553,
+    0x53495650,
+    0x53495650,
+    0x50584542,
+    0x50584542,
+    0x50584542,
+    0x50584542,
+    0x50584542,
+    0x50414d50,
+    0x50414d50,
+    0x50414d50,
+    0x50414d50,
+    0x534e4950,
+    0x534e4950,
+    0x534e4950,
+    0x534e4950,
+    0x314e4f42,
+    0x314e4f42,
+    0x314e4f42,
+    0x314e4f42,
+    0x4c554f53,
+    0x4c554f53,
+    0x4c554f53,
+    0x4c554f53,
+    0x324e4f42,
+    0x324e4f42,
+    0x324e4f42,
+    0x324e4f42,
+    0x44455254,
+    0x44455254,
+    0x44455254,
+    0x44455254,
+    0x4e455f53,
+    0x54535f50,
+    0x535f3150,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x5f333157,
+    0x5f333157,
+    0x5f333157,
+    0x5f353157,
+    0x5f353157,
+    0x5f373157,
+    0x4c4c4157,
+    0x5f383257,
+    0x5f383257,
+    0x5f383257,
+    0x5f383257,
+    0x5f313357,
+    0x5f323357,
+    0x5f323357,
+    0x5f333357,
+    0x5f333357,
+    0x5f333357,
+    0x5f363457,
+    0x5f363457,
+    0x5f363457,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x4c4c4157,
+    0x5f343957,
+    0x31313157,
+    0x31313157,
+    0x32313157,
+    0x32313157,
+    0x32313157,
+    0x33313157,
+    0x33313157,
+    0x33313157,
+    0x31315753,
+    0x31315753,
+    0x31315753,
+    0x31315753,
+    0x32315753,
+    0x32315753,
+    0x32315753,
+    0x32315753,
+    0x39315753,
+    0x39315753,
+    0x39315753,
+    0x39315753,
+    0x37315753,
+    0x37315753,
+    0x37315753,
+    0x38315753,
+    0x38315753,
+    0x5f343154,
+    0x32314741,
+    0x32314741,
+    0x31424741,
+    0x31414c57,
+    0x50505553,
+    0x574d4f54,
+    0x574d4f54,
+    0x50455453,
+    0x50455453,
+    0x50455453,
+    0x50455453,
+    0x50455453,
+    0x50455453,
+    0x50455453,
+    0x50455453,
+    0x54495845,
+    0x54495845,
+    0x54414c50,
+    0x4c415454,
+    0x5f325054,
+    0x5f325054,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x504d4f43,
+    0x524f4f44,
+    0x524f4f44,
+    0x524f4f44,
+    0x524f4f44,
+    0x524f4f44,
+    0x524f4f44,
+    0x524f4f44,
+    0x524f4f44,
+    0x4e524157,
+    0x4e524157,
+    0x54494c42,
+    0x54494c42,
+    0x54494c42,
+    0x54494c57,
+    0x54494c57,
+    0x54494c57,
+    0x454b554e,
+    0x4d414c46,
+    0x52435354,
+    0x52435354,
+    0x52435354,
+    0x52435354,
+    0x52435354,
+    0x52435354,
+    0x30325350,
+    0x53315753,
+    0x53315753,
+    0x53325753,
+    0x53325753,
+    0x53335753,
+    0x53335753,
+    0x53345753,
+    0x53345753,
+    0x31594b53,
+    0x455f3150,
+    0x4e455f50,
+    0x54535f46,
+    0x535f3146,
+    0x4f4f4c46,
+    0x4f4f4c46,
+    0x4f4f4c46,
+    0x4f4f4c46,
+    0x4f4f4c46,
+    0x4f4f4c46,
+    0x4f4f4c46,
+    0x4f4f4c46,
+    0x4f4f4c46,
+    0x4f4f4c46,
+    0x4f4f4c46,
+    0x4f4f4c46,
+    0x4f4f4c46,
+    0x4f4f4c46,
+    0x50455453,
+    0x50455453,
+    0x4f4f4c46,
+    0x4f4f4c46,
+    0x54494c54,
+    0x54494c54,
+    0x54494c54,
+    0x54494c54,
+    0x4f4f4c46,
+    0x4f4f4c46,
+    0x524c464d,
+    0x314d4544,
+    0x314d4544,
+    0x314d4544,
+    0x314d4544,
+    0x4c494543,
+    0x4c494543,
+    0x4c494543,
+    0x4c494543,
+    0x4c494543,
+    0x4c494543,
+    0x4c494543,
+    0x54414c46,
+    0x54414c46,
+    0x54414c46,
+    0x54414c46,
+    0x54414c46,
+    0x54414c46,
+    0x54414c46,
+    0x54414c46,
+    0x54414c46,
+    0x54414c46,
+    0x54414c46,
+    0x534e4f43,
+    0x534e4f43,
+    0x534e4f43,
+    0x414b554e,
+    0x414b554e,
+    0x414b554e,
+    0x4b535f46,
+    0x455f3146,
+    0x4e455f46,
+    0x44455243,
+    0x52415f4d,
+    0x41475f4d,
+    0x41475453,
+    0x41475453,
+    0x41475453,
+    0x41475453,
+    0x41475453,
+    0x41475453,
+    0x41475453,
+    0x41475453,
+    0x41475453,
+    0x41475453,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+    0x59414c50,
+};
+
+int32_t CONSTMEM _packedsize[WADLUMPS] = {
+    0,
+    5879,
+    1550,
+    12381,
+    9453,
+    5252,
+    0,
+    1053,
+    16240,
+    2446,
+    2615,
+    14222,
+    0,
+    5561,
+    802,
+    570,
+    4117,
+    0,
+    1976,
+    35156,
+    5979,
+    5262,
+    28448,
+    0,
+    10429,
+    1696,
+    2145,
+    7608,
+    0,
+    2790,
+    35347,
+    5279,
+    5375,
+    27808,
+    0,
+    10919,
+    1614,
+    1867,
+    6407,
+    0,
+    1901,
+    28879,
+    4470,
+    4340,
+    22899,
+    0,
+    8313,
+    1388,
+    1531,
+    5331,
+    0,
+    2228,
+    28748,
+    4432,
+    4229,
+    22200,
+    0,
+    9074,
+    1403,
+    1649,
+    5417,
+    0,
+    3463,
+    45279,
+    7023,
+    6707,
+    35929,
+    0,
+    13940,
+    1902,
+    2918,
+    10147,
+    0,
+    2606,
+    33131,
+    5400,
+    5035,
+    26673,
+    0,
+    10999,
+    1640,
+    1686,
+    6250,
+    0,
+    883,
+    11186,
+    2137,
+    1822,
+    11268,
+    0,
+    3986,
+    571,
+    209,
+    8548,
+    0,
+    1713,
+    21360,
+    3644,
+    3157,
+    18814,
+    0,
+    6497,
+    915,
+    1869,
+    4703,
+    4631,
+    1903,
+    3436,
+    41273,
+    45790,
+    42704,
+    49981,
+    0,
+    0,
+    0,
+    0,
+    0,
+    51,
+    0,
+    0,
+    53,
+    0,
+    7598,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    101,
+    0,
+    182,
+    265,
+    266,
+    241,
+    279,
+    278,
+    200,
+    267,
+    272,
+    270,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    82,
+    79,
+    82,
+    97,
+    98,
+    101,
+    210,
+    0,
+    1256,
+    59,
+    68,
+    93,
+    111,
+    124,
+    0,
+    0,
+    0,
+    0,
+    81,
+    0,
+    0,
+    56,
+    0,
+    0,
+    101,
+    73,
+    112,
+    112,
+    99,
+    100,
+    114,
+    105,
+    104,
+    115,
+    69,
+    58,
+    0,
+    60,
+    0,
+    106,
+    126,
+    108,
+    114,
+    121,
+    115,
+    112,
+    103,
+    108,
+    104,
+    59,
+    105,
+    118,
+    90,
+    125,
+    114,
+    103,
+    106,
+    116,
+    113,
+    102,
+    105,
+    104,
+    0,
+    118,
+    128,
+    106,
+    104,
+    81,
+    0,
+    0,
+    82,
+    64,
+    59,
+    181,
+    181,
+    181,
+    181,
+    184,
+    184,
+    184,
+    184,
+    595,
+    610,
+    610,
+    0,
+    0,
+    671,
+    590,
+    580,
+    629,
+    0,
+    0,
+    0,
+    0,
+    678,
+    644,
+    617,
+    648,
+    688,
+    684,
+    0,
+    0,
+    706,
+    661,
+    641,
+    698,
+    0,
+    0,
+    0,
+    0,
+    701,
+    672,
+    619,
+    729,
+    0,
+    0,
+    0,
+    0,
+    733,
+    704,
+    680,
+    586,
+    0,
+    5342,
+    1717,
+    1419,
+    1741,
+    1542,
+    376,
+    378,
+    0,
+    105,
+    139,
+    110,
+    1673,
+    1089,
+    1382,
+    504,
+    490,
+    2308,
+    2660,
+    2487,
+    1185,
+    2205,
+    2612,
+    2650,
+    2783,
+    1687,
+    2501,
+    2118,
+    2135,
+    1426,
+    1573,
+    1652,
+    1289,
+    2248,
+    594,
+    636,
+    2324,
+    2583,
+    1657,
+    1792,
+    1898,
+    1970,
+    2078,
+    159,
+    150,
+    160,
+    0,
+    87,
+    0,
+    0,
+    0,
+    0,
+    84,
+    37,
+    51512,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    180,
+    182,
+    182,
+    0,
+    0,
+    0,
+    359,
+    359,
+    359,
+    0,
+    0,
+    124,
+    736,
+    727,
+    0,
+    750,
+    879,
+    1276,
+    866,
+    790,
+    218,
+    667,
+    627,
+    691,
+    66,
+    226,
+    182,
+    117,
+    192,
+    182,
+    176,
+    191,
+    192,
+    155,
+    191,
+    197,
+    84,
+    965,
+    862,
+    1212,
+    1935,
+    1868,
+    2146,
+    1653,
+    2648,
+    2604,
+    2323,
+    2023,
+    2179,
+    1157,
+    2134,
+    2650,
+    2000,
+    2021,
+    2283,
+    1237,
+    2682,
+    1903,
+    2086,
+    2592,
+    1571,
+    1945,
+    554,
+    1374,
+    1795,
+    2157,
+    325,
+    406,
+    395,
+    379,
+    325,
+    406,
+    395,
+    378,
+    393,
+    635,
+    1026,
+    1205,
+    0,
+    0,
+    7072,
+    2168,
+    1872,
+    4916,
+    4931,
+    5457,
+    5584,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    1283,
+    1557,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    1803,
+    0,
+    4760,
+    2874,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    146,
+    211,
+    1160,
+    894,
+    0,
+    0,
+    0,
+    212,
+    215,
+    0,
+    1016,
+    719,
+    0,
+    87,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    1168,
+    1237,
+    1122,
+    1187,
+    0,
+    0,
+    0,
+    5788,
+    2998,
+    3217,
+    1313,
+    2676,
+    3775,
+    3012,
+    220,
+    462,
+    587,
+    393,
+    212,
+    2146,
+    6744,
+    6731,
+    7177,
+    1009,
+    1274,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    1495,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    1498,
+    0,
+    0,
+    0,
+    0,
+    1537,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    1728,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    1765,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    1261,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    1394,
+    0,
+    0,
+    0,
+    1022,
+    1357,
+    0,
+    0,
+    0,
+    972,
+    1383,
+    0,
+    0,
+    0,
+    1024,
+    1314,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    1093,
+    1018,
+    0,
+    0,
+    0,
+    1028,
+    0,
+    0,
+    0,
+    0,
+    1158,
+    0,
+    0,
+    0,
+    0,
+    0,
+    1172,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    394,
+    0,
+    0,
+    0,
+    0,
+    1112,
+    1469,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    1119,
+    0,
+    0,
+    0,
+    0,
+    1147,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    213,
+    715,
+    744,
+    846,
+    877,
+    1250,
+    130,
+    115,
+    278,
+    203,
+    408,
+    456,
+    435,
+    435,
+    444,
+    777,
+    773,
+    628,
+    502,
+    876,
+    314,
+    447,
+    3158,
+    290,
+    290,
+    280,
+    280,
+    0,
+    0,
+    868,
+    466,
+    481,
+    771,
+    764,
+    0,
+    0,
+    0,
+    580,
+    614,
+    631,
+    645,
+    618,
+    609,
+    606,
+    609,
+    0,
+    0,
+    0,
+    0,
+    560,
+    563,
+    561,
+    580,
+    0,
+    0,
+    312,
+    0,
+    946,
+    906,
+    906,
+    937,
+    0,
+    0,
+    0,
+    4925,
+    1689,
+    1403,
+    1594,
+    1555,
+    1500,
+    1705,
+    1046,
+    955,
+    1010,
+    999,
+    1019,
+    1027,
+    1068,
+    1075,
+    1120,
+    1109,
+    1092,
+    1063,
+    3490,
+    3553,
+    1486,
+    3406,
+    3678,
+    2826,
+    990,
+    967,
+    963,
+    962,
+    1037,
+    2974,
+    587,
+    206,
+    569,
+    1571,
+    858,
+    18942,
+    23863,
+    2546,
+    2796,
+    2809,
+    2845,
+    2817,
+    2943,
+    2851,
+    2693,
+    2785,
+    761,
+    168,
+    167,
+    165,
+    2345,
+    3494,
+    3502,
+    3537,
+    9397,
+    4376,
+    14899,
+    2862,
+    2990,
+    2688,
+    1643,
+    1664,
+    7480,
+    2920,
+    2961,
+    2313,
+    2328,
+    2132,
+    2139,
+    2120,
+    2086,
+    2214,
+    2151,
+    4755,
+    4800,
+    4709,
+    4600,
+    2374,
+    2477,
+    2461,
+    2210,
+    2210,
+    447,
+    652,
+    1140,
+    379,
+    2115,
+    793,
+    3914,
+    3795,
+    251,
+    296,
+    160,
+    354,
+    435,
+    240,
+    309,
+    449,
+    428,
+    105,
+    7117,
+    348,
+    10671,
+    9051,
+    2240,
+    1954,
+    1951,
+    2031,
+    2515,
+    2485,
+    2291,
+    2293,
+    1613,
+    2093,
+    1912,
+    2128,
+    1896,
+    2566,
+    184,
+    1223,
+    473,
+    410,
+    338,
+    1986,
+    1811,
+    1461,
+    2505,
+    2622,
+    681,
+    762,
+    3373,
+    8935,
+    1396,
+    1244,
+    1256,
+    2612,
+    437,
+    8663,
+    299,
+    233,
+    110,
+    63,
+    112,
+    110,
+    63,
+    112,
+    1733,
+    606,
+    1953,
+    2904,
+    2351,
+    2004,
+    1126,
+    1697,
+    1087,
+    688,
+    679,
+    620,
+    708,
+    666,
+    682,
+    382,
+    397,
+    24118,
+    0,
+    0,
+    0,
+    0,
+    2349,
+    2564,
+    1765,
+    2207,
+    1678,
+    2939,
+    2459,
+    2116,
+    2149,
+    2904,
+    3126,
+    2553,
+    2558,
+    2722,
+    2186,
+    1756,
+    3177,
+    3087,
+    2274,
+    2638,
+    2170,
+    2524,
+    2907,
+    2485,
+    2270,
+    3174,
+    3131,
+    3216,
+    3282,
+    2546,
+    2465,
+    2083,
+    271,
+    1113,
+    2309,
+    2757,
+    3017,
+    2231,
+    2554,
+    2827,
+    2260,
+    2632,
+    147,
+    3061,
+    1633,
+    3445,
+    2796,
+    1853,
+    1803,
+    1455,
+    2598,
+    2656,
+    2735,
+    3017,
+    0,
+    0,
+    0,
+    2130,
+    1914,
+    198,
+    145,
+    210,
+    206,
+    175,
+    204,
+    199,
+    153,
+    203,
+    201,
+    0,
+    0,
+    0,
+    9286,
+    9005,
+};
+
+uint32_t CONSTMEM _lumphash_seed[LUMPHASH_BUCKETS] = {
+    191,
+    135,
+    3,
+    39,
+    12,
+    11,
+    2,
+    26,
+    56,
+    19,
+    3,
+    213,
+    4,
+    183,
+    42,
+    1,
+    230,
+    2,
+    28,
+    172,
+    1,
+    80,
+    1,
+    265,
+    21,
+    177,
+    4,
+    1,
+    10,
+    8,
+    7,
+    2,
+    2,
+    30,
+    20,
+    500,
+    1,
+    34,
+    36,
+    33,
+    1,
+    2,
+    6,
+    51,
+    0,
+    944,
+    41,
+    32,
+    204,
+    5,
+    344,
+    204,
+    2,
+    1,
+    1,
+    8,
+    21,
+    7,
+    26,
+    519,
+    1,
+    7,
+    9,
+    154,
+    53,
+    202,
+    9,
+    3,
+    364,
+    21,
+    0,
+    155,
+    526,
+    46,
+    3,
+    240,
+    80,
+    601,
+    21,
+    85,
+    7,
+    58,
+    12,
+    45,
+    14,
+    52,
+    9,
+    189,
+    6,
+    28,
+    3,
+    4,
+    68,
+    1,
+    14,
+    11,
+    8,
+    1,
+    40,
+    129,
+    151,
+    41,
+    42,
+    1,
+    9,
+    67,
+    7,
+    15,
+    23,
+    19,
+    20,
+    7,
+    5,
+    10,
+    48,
+    6,
+    9,
+    76,
+    3,
+    36,
+    231,
+    351,
+    66,
+    100,
+    11,
+    55,
+    156,
+    100,
+    16,
+    484,
+    6,
+    1,
+    128,
+    35,
+    150,
+    69,
+    3,
+    25,
+    3,
+    222,
+    141,
+    146,
+    3,
+    63,
+    4,
+    4,
+    170,
+    3,
+    505,
+    13,
+    3,
+    718,
+    13,
+    192,
+    139,
+    1,
+    7,
+    81,
+    142,
+    0,
+    5,
+    4,
+    30,
+    139,
+    666,
+    444,
+    129,
+    114,
+    25,
+    1,
+    103,
+    197,
+    472,
+    18,
+    288,
+    792,
+    349,
+    4,
+    2,
+    24,
+    21,
+    1,
+    19,
+    81,
+    12,
+    1985,
+    427,
+    8,
+    17,
+    27,
+    53,
+    12,
+    179,
+    29,
+    1273,
+    2,
+    325,
+    148,
+    433,
+    2,
+    1,
+    245,
+    878,
+    442,
+    153,
+    73,
+    123,
+    1475,
+    195,
+    2,
+    327,
+    541,
+    1,
+    0,
+    77,
+    0,
+    35,
+    210,
+    2137,
+    2,
+    287,
+    794,
+    18,
+    340,
+    94,
+    23,
+    1522,
+    485,
+    0,
+    3076,
+    603,
+    11,
+    520,
+    264,
+    3,
+    2,
+    40,
+    7,
+    5,
+    64,
+    7,
+    1641,
+    359,
+    16,
+    367,
+    50,
+    57,
+    11,
+    1241,
+    119,
+    144,
+    455,
+    4,
+    1186,
+    4,
+    2708,
+    1,
+    2,
+    803,
+    3278,
+    656,
+    2,
+    2731,
+    174,
+    1,
+    580,
+    18,
+    608,
+    300,
+    2,
+};
+
+int32_t CONSTMEM _lumphash_index[LUMPHASH_SLOTS] = {
+    592,
+    1135,
+    278,
+    397,
+    742,
+    488,
+    552,
+    462,
+    623,
+    666,
+    585,
+    572,
+    1049,
+    1098,
+    337,
+    610,
+    1017,
+    5,
+    575,
+    968,
+    536,
+    1025,
+    697,
+    554,
+    919,
+    218,
+    901,
+    738,
+    348,
+    582,
+    324,
+    438,
+    1048,
+    387,
+    336,
+    465,
+    199,
+    453,
+    660,
+    799,
+    853,
+    667,
+    339,
+    642,
+    1072,
+    111,
+    841,
+    511,
+    313,
+    484,
+    856,
+    517,
+    535,
+    294,
+    1142,
+    131,
+    811,
+    537,
+    1009,
+    977,
+    203,
+    1030,
+    731,
+    583,
+    580,
+    577,
+    143,
+    390,
+    308,
+    406,
+    1058,
+    282,
+    1023,
+    146,
+    918,
+    321,
+    559,
+    501,
+    980,
+    503,
+    607,
+    958,
+    732,
+    886,
+    929,
+    713,
+    188,
+    686,
+    412,
+    1152,
+    233,
+    947,
+    1055,
+    471,
+    1059,
+    152,
+    843,
+    1065,
+    194,
+    230,
+    216,
+    284,
+    848,
+    472,
+    814,
+    820,
+    768,
+    15,
+    619,
+    422,
+    902,
+    160,
+    185,
+    645,
+    815,
+    0,
+    236,
+    424,
+    266,
+    586,
+    850,
+    976,
+    1117,
+    760,
+    631,
+    922,
+    507,
+    411,
+    698,
+    352,
+    927,
+    162,
+    696,
+    451,
+    317,
+    617,
+    833,
+    385,
+    137,
+    17,
+    334,
+    1066,
+    195,
+    900,
+    948,
+    289,
+    310,
+    369,
+    271,
+    613,
+    1010,
+    661,
+    716,
+    540,
+    1037,
+    273,
+    917,
+    142,
+    520,
+    219,
+    498,
+    1004,
+    663,
+    502,
+    1028,
+    380,
+    584,
+    1021,
+    1147,
+    437,
+    306,
+    981,
+    966,
+    395,
+    292,
+    487,
+    285,
+    868,
+    267,
+    356,
+    685,
+    360,
+    794,
+    522,
+    639,
+    430,
+    571,
+    140,
+    389,
+    183,
+    445,
+    477,
+    626,
+    855,
+    741,
+    1121,
+    1013,
+    569,
+    641,
+    1154,
+    6,
+    130,
+    1022,
+    961,
+    1014,
+    1075,
+    441,
+    512,
+    1054,
+    1123,
+    393,
+    531,
+    342,
+    857,
+    993,
+    480,
+    449,
+    1099,
+    758,
+    989,
+    932,
+    121,
+    207,
+    375,
+    1105,
+    945,
+    544,
+    225,
+    167,
+    434,
+    818,
+    939,
+    364,
+    256,
+    890,
+    877,
+    774,
+    616,
+    701,
+    407,
+    979,
+    519,
+    120,
+    298,
+    795,
+    132,
+    499,
+    107,
+    985,
+    529,
+    861,
+    1001,
+    455,
+    595,
+    1006,
+    398,
+    296,
+    906,
+    159,
+    896,
+    355,
+    960,
+    365,
+    549,
+    750,
+    227,
+    1092,
+    638,
+    238,
+    105,
+    556,
+    867,
+    581,
+    249,
+    378,
+    1047,
+    275,
+    936,
+    715,
+    733,
+    370,
+    362,
+    118,
+    844,
+    1106,
+    1050,
+    937,
+    515,
+    865,
+    428,
+    1042,
+    956,
+    735,
+    578,
+    1083,
+    874,
+    802,
+    783,
+    205,
+    476,
+    675,
+    1056,
+    872,
+    486,
+    1096,
+    720,
+    280,
+    1104,
+    344,
+    527,
+    812,
+    479,
+    1124,
+    326,
+    722,
+    602,
+    1146,
+    539,
+    211,
+    589,
+    570,
+    840,
+    659,
+    926,
+    999,
+    259,
+    270,
+    629,
+    3,
+    122,
+    971,
+    246,
+    166,
+    778,
+    930,
+    405,
+    426,
+    618,
+    1051,
+    148,
+    228,
+    725,
+    1045,
+    1019,
+    608,
+    260,
+    350,
+    620,
+    852,
+    746,
+    1,
+    729,
+    459,
+    466,
+    338,
+    244,
+    119,
+    793,
+    658,
+    217,
+    763,
+    789,
+    303,
+    416,
+    359,
+    173,
+    223,
+    991,
+    440,
+    1071,
+    934,
+    908,
+    949,
+    1000,
+    269,
+    11,
+    788,
+    627,
+    757,
+    588,
+    928,
+    624,
+    257,
+    767,
+    1126,
+    333,
+    705,
+    826,
+    373,
+    555,
+    231,
+    756,
+    417,
+    1002,
+    967,
+    1102,
+    186,
+    647,
+    1139,
+    302,
+    1091,
+    1130,
+    504,
+    677,
+    568,
+    1107,
+    810,
+    125,
+    587,
+    770,
+    693,
+    538,
+    214,
+    880,
+    747,
+    213,
+    394,
+    1137,
+    314,
+    1100,
+    816,
+    831,
+    399,
+    775,
+    288,
+    485,
+    558,
+    127,
+    431,
+    903,
+    381,
+    1094,
+    648,
+    689,
+    699,
+    825,
+    396,
+    83,
+    1157,
+    1134,
+    594,
+    110,
+    311,
+    1053,
+    180,
+    490,
+    458,
+    197,
+    325,
+    346,
+    392,
+    176,
+    408,
+    509,
+    391,
+    863,
+    28,
+    212,
+    464,
+    513,
+    496,
+    533,
+    914,
+    461,
+    904,
+    621,
+    832,
+    1038,
+    1128,
+    454,
+    766,
+    1129,
+    1069,
+    1084,
+    425,
+    553,
+    942,
+    1005,
+    965,
+    761,
+    409,
+    891,
+    299,
+    548,
+    239,
+    456,
+    368,
+    329,
+    452,
+    864,
+    871,
+    962,
+    423,
+    116,
+    912,
+    138,
+    1078,
+    331,
+    809,
+    669,
+    506,
+    679,
+    1061,
+    448,
+    1067,
+    109,
+    797,
+    827,
+    413,
+    779,
+    541,
+    690,
+    528,
+    16,
+    526,
+    700,
+    1081,
+    800,
+    129,
+    483,
+    813,
+    796,
+    873,
+    1044,
+    834,
+    332,
+    649,
+    221,
+    973,
+    1119,
+    495,
+    382,
+    514,
+    888,
+    290,
+    737,
+    328,
+    220,
+    172,
+    184,
+    847,
+    436,
+    12,
+    1148,
+    354,
+    916,
+    126,
+    724,
+    295,
+    1097,
+    9,
+    388,
+    625,
+    500,
+    492,
+    1133,
+    193,
+    427,
+    743,
+    703,
+    1074,
+    1015,
+    664,
+    644,
+    469,
+    923,
+    376,
+    1027,
+    377,
+    1131,
+    806,
+    935,
+    726,
+    1034,
+    593,
+    1062,
+    674,
+    723,
+    702,
+    307,
+    776,
+    153,
+    200,
+    347,
+    1064,
+    1138,
+    265,
+    518,
+    845,
+    1087,
+    372,
+    156,
+    175,
+    291,
+    279,
+    694,
+    881,
+    262,
+    145,
+    893,
+    446,
+    215,
+    1031,
+    708,
+    803,
+    597,
+    1156,
+    941,
+    14,
+    823,
+    736,
+    351,
+    862,
+    551,
+    972,
+    202,
+    887,
+    530,
+    565,
+    250,
+    433,
+    1151,
+    174,
+    8,
+    190,
+    251,
+    112,
+    734,
+    1141,
+    357,
+    253,
+    943,
+    1036,
+    263,
+    772,
+    662,
+    1089,
+    804,
+    1109,
+    128,
+    754,
+    992,
+    839,
+    196,
+    1011,
+    974,
+    371,
+    562,
+    828,
+    157,
+    640,
+    232,
+    695,
+    1040,
+    255,
+    470,
+    676,
+    415,
+    744,
+    224,
+    566,
+    335,
+    1101,
+    403,
+    1024,
+    1155,
+    849,
+    374,
+    305,
+    655,
+    899,
+    151,
+    1029,
+    876,
+    330,
+    915,
+    468,
+    909,
+    243,
+    432,
+    384,
+    420,
+    1127,
+    753,
+    798,
+    925,
+    986,
+    635,
+    759,
+    897,
+    996,
+    124,
+    907,
+    835,
+    609,
+    604,
+    573,
+    482,
+    421,
+    790,
+    905,
+    182,
+    931,
+    323,
+    777,
+    547,
+    439,
+    179,
+    366,
+    955,
+    755,
+    984,
+    837,
+    854,
+    463,
+    1041,
+    481,
+    1113,
+    252,
+    670,
+    591,
+    363,
+    1149,
+    210,
+    546,
+    665,
+    911,
+    668,
+    940,
+    611,
+    892,
+    622,
+    650,
+    600,
+    135,
+    208,
+    473,
+    784,
+    842,
+    13,
+    108,
+    1118,
+    1007,
+    728,
+    450,
+    1136,
+    970,
+    884,
+    739,
+    590,
+    1079,
+    765,
+    240,
+    287,
+    155,
+    178,
+    61,
+    969,
+    819,
+    1080,
+    680,
+    510,
+    4,
+    429,
+    1026,
+    340,
+    808,
+    858,
+    532,
+    1153,
+    379,
+    651,
+    711,
+    1090,
+    879,
+    1063,
+    785,
+    557,
+    998,
+    254,
+    341,
+    762,
+    264,
+    177,
+    601,
+    139,
+    1111,
+    646,
+    206,
+    748,
+    1033,
+    404,
+    545,
+    2,
+    242,
+    247,
+    714,
+    1112,
+    878,
+    727,
+    505,
+    72,
+    567,
+    524,
+    343,
+    933,
+    1057,
+    870,
+    147,
+    494,
+    222,
+    1020,
+    274,
+    1093,
+    383,
+    261,
+    293,
+    612,
+    889,
+    327,
+    1150,
+    953,
+    170,
+    704,
+    318,
+    1095,
+    684,
+    460,
+    563,
+    751,
+    516,
+    764,
+    301,
+    367,
+    921,
+    281,
+    678,
+    898,
+    946,
+    1122,
+    682,
+    630,
+    115,
+    534,
+    478,
+    493,
+    885,
+    154,
+    615,
+    134,
+    442,
+    780,
+    1103,
+    882,
+    988,
+    730,
+    598,
+    1018,
+    654,
+    1125,
+    954,
+    643,
+    894,
+    1073,
+    286,
+    144,
+    123,
+    133,
+    1032,
+    248,
+    277,
+    550,
+    838,
+    1145,
+    349,
+    749,
+    444,
+    315,
+    268,
+    229,
+    924,
+    801,
+    106,
+    920,
+    192,
+    706,
+    201,
+    258,
+    209,
+    740,
+    94,
+    628,
+    164,
+    636,
+    657,
+    1046,
+    829,
+    787,
+    910,
+    39,
+    652,
+    1120,
+    165,
+    1052,
+    1035,
+    1114,
+    141,
+    1068,
+    189,
+    322,
+    709,
+    168,
+    987,
+    564,
+    457,
+    161,
+    830,
+    1110,
+    673,
+    869,
+    467,
+    781,
+    603,
+    614,
+    1143,
+    491,
+    773,
+    542,
+    1086,
+    113,
+    913,
+    712,
+    817,
+    358,
+    418,
+    319,
+    272,
+    316,
+    717,
+    1016,
+    353,
+    786,
+    226,
+    653,
+    859,
+    447,
+    634,
+    994,
+    312,
+    574,
+    204,
+    688,
+    187,
+    419,
+    792,
+    1085,
+    824,
+    599,
+    401,
+    860,
+    978,
+    1043,
+    304,
+    414,
+    822,
+    983,
+    191,
+    297,
+    245,
+    50,
+    1003,
+    895,
+    169,
+    474,
+    633,
+    443,
+    171,
+    606,
+    114,
+    475,
+    525,
+    1115,
+    10,
+    964,
+    821,
+    782,
+    579,
+    952,
+    875,
+    851,
+    1008,
+    7,
+    345,
+    938,
+    235,
+    791,
+    605,
+    410,
+    561,
+    150,
+    241,
+    158,
+    1140,
+    508,
+    435,
+    681,
+    951,
+    692,
+    671,
+    136,
+    771,
+    596,
+    745,
+    963,
+    1116,
+    309,
+    719,
+    846,
+    1070,
+    163,
+    283,
+    710,
+    957,
+    718,
+    198,
+    707,
+    656,
+    402,
+    1082,
+    975,
+    117,
+    836,
+    320,
+    276,
+    1039,
+    149,
+    637,
+    1144,
+    883,
+    769,
+    1088,
+    721,
+    1060,
+    523,
+    1132,
+    995,
+    1108,
+    990,
+    300,
+    807,
+    386,
+    1077,
+    489,
+    944,
+    687,
+    361,
+    543,
+    752,
+    691,
+    959,
+    234,
+    497,
+    576,
+    866,
+    632,
+    400,
+    805,
+    1012,
+    1076,
+    521,
+    237,
+    950,
+    683,
+    982,
+    560,
+    672,
+    181,
+};
+
+// Array representations
+ConstMemArray<int32_t> filepos(_filepos);
+ConstMemArray<int32_t> lumpsize(_lumpsize);
+ConstMemArray<uint32_t> lumpname_high(_lumpname_high);
+ConstMemArray<uint32_t> lumpname_low(_lumpname_low);
+ConstMemArray<int32_t> packedsize(_packedsize);
+ConstMemArray<uint32_t> lumphash_seed(_lumphash_seed);
+ConstMemArray<int32_t> lumphash_index(_lumphash_index);
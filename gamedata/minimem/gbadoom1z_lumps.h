@@ -0,0 +1,50 @@
+#ifndef _GBADOOM1Z_LUMPS_H_
+#define _GBADOOM1Z_LUMPS_H_
+
+#include <stdint.h>
+#include "annotations.h"
+
+#define WADLUMPS 1158
+#define LUMPHASH_BUCKETS 270
+#define LUMPHASH_SLOTS 1077
+
+
+extern ConstMemArray<int32_t> filepos;
+extern ConstMemArray<int32_t> lumpsize;
+extern ConstMemArray<uint32_t> lumpname_high;
+extern ConstMemArray<uint32_t> lumpname_low;
+
+// Lumps with a packed size are LZ4 packed, and need WADPACK_MARGIN bytes more than
+// their size to be decompressed in place
+#define WADPACK_MARGIN 4
+extern ConstMemArray<int32_t> packedsize;
+
+// Minimal perfect hash of the lump names, see LumpNameIndex() for how to look up a name
+extern ConstMemArray<uint32_t> lumphash_seed;
+extern ConstMemArray<int32_t> lumphash_index;
+
+static inline uint32_t LumpNameHash(uint32_t name_low, uint32_t name_high, uint32_t seed)
+{
+    uint32_t h = (name_low ^ seed) * 0x9e3779b1u;
+    h ^= h >> 15;
+    h ^= name_high;
+    h *= 0x85ebca77u;
+    h ^= h >> 13;
+    return h;
+}
+
+// Maps a hash onto 0..n-1 with a multiply instead of a division
+static inline uint32_t LumpHashReduce(uint32_t h, uint32_t n)
+{
+    return ((uint64_t)h * n) >> 32;
+}
+
+// The only lump that can have the given name. Names that aren't in the WAD map to
+// some lump too, so the caller must compare the name.
+static inline int LumpNameIndex(uint32_t name_low, uint32_t name_high)
+{
+    uint32_t seed = lumphash_seed[LumpHashReduce(LumpNameHash(name_low, name_high, 0), LUMPHASH_BUCKETS)];
+    return lumphash_index[LumpHashReduce(LumpNameHash(name_low, name_high, seed), LUMPHASH_SLOTS)];
+}
+
+#endif // _GBADOOM1Z_LUMPS_H_
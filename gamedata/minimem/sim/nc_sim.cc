@@ -0,0 +1,174 @@
+/**
+ * Offline NewCache simulator.
+ *
+ * Replays an access trace recorded by a build with NC_ACCESSTRACE=1 against the real
+ * cache (../w_nc.cc) and heap (../tagheap.cc), built with the heap size given by 
+ * TH_CACHEHEAPSIZE and the eviction policy given by NC_EVICTION_POLICY on the command
+ * line. Nothing is read from the WAD - only the lump directory is needed to reproduce
+ * allocation, eviction and defragmentation.
+ *
+ * Prints one CSV row per map (and one for the whole trace):
+ *   policy,heapsize,map,accesses,misses,missratio,evictions,defrags,defragbytes,bytesread
+ *
+ * If the cache runs out of memory, which it treats as fatal, the row for the current map
+ * and the total are printed with "oom" as miss ratio.
+ */
+
+#include "../../newcache/newcache.h"
+#include "../../include/r_defs.h"
+#include "../wadreader.h"
+#include "../tagheap.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Name of the eviction policy the cache was built with, for the report
+#ifndef SIM_POLICY
+#define SIM_POLICY "default"
+#endif
+
+// Objects that the cache maps permanently
+unsigned char gfx_stbar[1];
+line_t junk;
+
+// The cache reads through the wadreader. Lump contents don't matter to the simulation.
+void WR_Init()
+{
+}
+
+void WR_Read(uint8_t *dst, int offset, int len)
+{
+    (void)offset;
+    memset(dst,0,len);
+}
+
+void WR_ReadV(const wr_request_t *reqs, int count)
+{
+    for (int i=0; i<count; i++)
+        memset(reqs[i].dst,0,reqs[i].len);
+}
+
+uint32_t WR_FlashTime()
+{
+    return 0;
+}
+
+static char mapname[9] = "-";
+static nc_stats_t mapstart;
+static bool finished = false;
+
+static void PrintRow(const char *map, const nc_stats_t *from, bool oom)
+{
+    const nc_stats_t *now = NC_GetStats();
+    unsigned misses = now->misses - from->misses;
+    unsigned accesses = now->hits - from->hits + misses;
+    printf("%s,%d,%s,%u,%u,",SIM_POLICY,TH_CACHEHEAPSIZE,map,accesses,misses);
+    if (oom)
+        printf("oom,");
+    else
+        printf("%.5f,",accesses ? (double)misses/accesses : 0.0);
+    printf("%u,%u,%u,%u\n",
+        now->evictions - from->evictions,
+        now->defrags - from->defrags,
+        now->defragbytes - from->defragbytes,
+        now->bytesread - from->bytesread);
+}
+
+// The cache exits on out of memory - still report what was simulated
+static void AtExit()
+{
+    static const nc_stats_t zero = {};
+    if (finished) return;
+    PrintRow(mapname,&mapstart,true);
+    PrintRow("all",&zero,true);
+    fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 2) {
+        fprintf(stderr,"Usage: %s <ncaccess.trace>\n",argv[0]);
+        return 1;
+    }
+    FILE *f = fopen(argv[1],"rb");
+    if (!f) {
+        fprintf(stderr,"Can't open %s\n",argv[1]);
+        return 1;
+    }
+    NC_Init();
+    atexit(AtExit);
+
+    nc_tracerecord_t rec;
+    while (fread(&rec,sizeof(rec),1,f) == 1) {
+        switch (rec.op) {
+            case NC_TRACE_CACHE:
+                NC_CacheLumpNum(rec.arg);
+                break;
+            case NC_TRACE_PIN:
+                NC_Pin(rec.arg);
+                break;
+            case NC_TRACE_UNPIN:
+                NC_Unpin(rec.arg);
+                break;
+            case NC_TRACE_PREFETCH:
+                NC_Prefetch(rec.arg);
+                break;
+            case NC_TRACE_SERVICE:
+                NC_ServicePrefetch();
+                break;
+            case NC_TRACE_FLUSH:
+                NC_FlushCache();
+                break;
+            case NC_TRACE_ENDLEVEL:
+                NC_EndLevel();
+                break;
+            case NC_TRACE_LEVEL:
+                // A new map starts - report the one before it
+                if (strcmp(mapname,"-") != 0)
+                    PrintRow(mapname,&mapstart,false);
+                NC_GetNameForNum(rec.arg,mapname);
+                mapname[8] = 0;
+                mapstart = *NC_GetStats();
+                NC_BeginLevel(rec.arg);
+                break;
+            case NC_TRACE_TIC:
+                NC_LevelTic();
+                break;
+            case NC_TRACE_IDLEDEFRAG:
+                NC_IdleDefrag();
+                break;
+            case NC_TRACE_BEGINEPOCH:
+                NC_BeginEpoch();
+                break;
+            case NC_TRACE_ENDEPOCH:
+                NC_EndEpoch();
+                break;
+            case NC_TRACE_EPOCHPTR:
+                NC_EpochPtr(rec.arg);
+                break;
+            case NC_TRACE_PINRANGE: {
+                nc_tracerecord_t range;
+                if (fread(&range,sizeof(range),1,f) != 1 || range.op != NC_TRACE_RANGE) {
+                    fprintf(stderr,"Range record missing\n");
+                    return 1;
+                }
+                NC_PinRange(rec.arg,range.arg<<4,range.aux<<4);
+                break;
+            }
+            case NC_TRACE_FRAME:
+                NC_EndFrame();
+                break;
+            default:
+                fprintf(stderr,"Unknown trace record '%c'\n",rec.op);
+                return 1;
+        }
+    }
+    fclose(f);
+
+    static const nc_stats_t zero = {};
+    PrintRow(mapname,&mapstart,false);
+    PrintRow("all",&zero,false);
+    finished = true;
+    return 0;
+}
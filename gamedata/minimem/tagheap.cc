@@ -15,13 +15,164 @@
 
 static bool initialized = false;
 
+// Where TH_defrag_step() continues compacting, or NULL to start from the bottom of the head.
+// It is reset when the block it points to may have gone away, or when memory is freed below it.
+static th_memblock_t *defragcursor = NULL;
+
 
 #define SZ_MEMBLOCK sizeof(th_memblock_t)
 
 uint8_t th_heap[TH_HEAPSIZE];
 
+/**
+ * Set TH_ALLOCTRACE to 1 to log every call into the heap API, and every block moved by
+ * defrag, to TH_ALLOCTRACE_FILE for replay in the benchmark in bench/
+ */
+#ifndef TH_ALLOCTRACE
+#define TH_ALLOCTRACE 0
+#endif
+
+#ifndef TH_ALLOCTRACE_FILE
+#define TH_ALLOCTRACE_FILE "thalloc.trace"
+#endif
+
+#if TH_ALLOCTRACE == 1
+#include <stdio.h>
+
+static FILE *alloctrace = NULL;
+
+static inline uint32_t traceoffset(const uint8_t *ptr) {
+    return ptr ? (uint32_t)(ptr - th_heap) : TH_TRACE_NULL;
+}
+
+static void TraceAlloc(char op, uint32_t tag, uint32_t size, const uint8_t *ptr, const uint8_t *result) {
+    if (!alloctrace) return;
+    th_tracerecord_t rec = {(uint32_t)op, tag, size, traceoffset(ptr), traceoffset(result)};
+    fwrite(&rec,sizeof(rec),1,alloctrace);
+}
+#define TRACE_ALLOC(op,tag,size,ptr,result) TraceAlloc(op,tag,size,ptr,result)
+#else
+#define TRACE_ALLOC(op,tag,size,ptr,result)
+#endif
+
 #define LASTBLOCK ((th_memblock_t *)&th_heap[TH_CACHEHEAPSIZE-SZ_MEMBLOCK+(tag >> 31)*TH_OBJECTHEAPSIZE])
 
+/**
+ * Free blocks are also kept in segregated lists, one per power of two size class and heap,
+ * so that allocation doesn't have to walk every block in the chain. The links live in the
+ * data area of the free block, which means blocks too small to hold them aren't listed. Those
+ * are too small to be allocated from anyway, and they are picked up again when merged. 
+ * 
+ * A listed block must not change size - unlink it, change it and link it again.
+ */
+typedef struct th_freelink_s {
+    th_memblock_t *prev;
+    th_memblock_t *next;
+} th_freelink_t;
+
+#define TH_SIZECLASSES 32
+
+static th_memblock_t *freelist[2][TH_SIZECLASSES];
+static uint32_t freeclasses[2]; // Bit n is set when freelist[heap][n] has blocks
+
+static inline th_freelink_t *freelink(th_memblock_t *block) {
+    return (th_freelink_t *)(block+1);
+}
+
+// 0 for the cache heap, 1 for the object heap
+static inline int heapof(th_memblock_t *block) {
+    return ((uint8_t *)block >= &th_heap[TH_CACHEHEAPSIZE]) ? 1 : 0;
+}
+
+static inline int sizeclass(unsigned size) {
+    return 31 - __builtin_clz(size | 1);
+}
+
+static void link_free(th_memblock_t *block) {
+    if (TH_size(block) < sizeof(th_freelink_t)) return;
+    int heap = heapof(block);
+    int sc = sizeclass(TH_size(block));
+    th_freelink_t *link = freelink(block);
+    link->prev = NULL;
+    link->next = freelist[heap][sc];
+    if (link->next) freelink(link->next)->prev = block;
+    freelist[heap][sc] = block;
+    freeclasses[heap] |= 1u << sc;
+}
+
+static void unlink_free(th_memblock_t *block) {
+    if (TH_size(block) < sizeof(th_freelink_t)) return;
+    int heap = heapof(block);
+    int sc = sizeclass(TH_size(block));
+    th_freelink_t *link = freelink(block);
+    if (link->prev) {
+        freelink(link->prev)->next = link->next;
+    } else {
+        freelist[heap][sc] = link->next;
+        if (!link->next) freeclasses[heap] &= ~(1u << sc);
+    }
+    if (link->next) freelink(link->next)->prev = link->prev;
+}
+
+/**
+ * Allocated blocks in the object heap are also kept in one list per tag, so that freeing a
+ * tag range only visits the blocks that have those tags. Tags from TH_TAGLISTS-1 and up
+ * share the last list. The links sit in the last bytes of the block, beyond the size asked
+ * for, and are word offsets (+1, so 0 means none) from the start of the object heap.
+ * Cache blocks aren't listed - they are moved by defrag and freed one lump at a time.
+ */
+#ifndef TH_TAGLISTS
+#define TH_TAGLISTS 8
+#endif
+
+typedef struct th_taglink_s {
+    th_field_t prev;
+    th_field_t next;
+} th_taglink_t;
+
+#define SZ_TAGLINK sizeof(th_taglink_t)
+static_assert(SZ_TAGLINK == TH_TAGLINKSIZE, "TH_TAGLINKSIZE must match th_taglink_t");
+#define OBJECTBASE (&th_heap[TH_CACHEHEAPSIZE])
+
+static th_memblock_t *taglist[TH_TAGLISTS];
+
+// Allocated blocks always have a next block, so this skips the end marker check of TH_next()
+static inline th_taglink_t *taglink(th_memblock_t *block) {
+    return (th_taglink_t *)((uint8_t *)(block+1) + TH_capacity(block) - SZ_TAGLINK);
+}
+
+static inline int tagclass(uint32_t tag) {
+    tag &= 0x7fffffff;
+    return (tag < TH_TAGLISTS-1) ? tag : TH_TAGLISTS-1;
+}
+
+static inline th_field_t tagref(th_memblock_t *block) {
+    return block ? (th_field_t)((((uint8_t *)block - OBJECTBASE) >> 2) + 1) : 0;
+}
+
+static inline th_memblock_t *tagderef(th_field_t ref) {
+    return ref ? (th_memblock_t *)(OBJECTBASE + ((ref - 1) << 2)) : NULL;
+}
+
+static void link_tag(th_memblock_t *block) {
+    int tc = tagclass(TH_tag(block));
+    th_taglink_t *link = taglink(block);
+    link->prev = 0;
+    link->next = tagref(taglist[tc]);
+    if (taglist[tc]) taglink(taglist[tc])->prev = tagref(block);
+    taglist[tc] = block;
+}
+
+static void unlink_tag(th_memblock_t *block) {
+    th_taglink_t *link = taglink(block);
+    if (link->prev) {
+        taglink(tagderef(link->prev))->next = link->next;
+    } else {
+        taglist[tagclass(TH_tag(block))] = tagderef(link->next);
+    }
+    if (link->next) taglink(tagderef(link->next))->prev = link->prev;
+}
+
 // Init the heap with start and end markers indicating the free space
 void TH_init() {
     if (initialized) return;
@@ -29,14 +180,14 @@ void TH_init() {
     // Initialize the start and end markers
     unsigned tag = 0;
     do {
-        FIRSTBLOCK->next = LASTBLOCK;
-        FIRSTBLOCK->prev = NULL;
-        FIRSTBLOCK->tag = TH_FREE_TAG;
-        FIRSTBLOCK->size = ((tag) ? TH_OBJECTHEAPSIZE : TH_CACHEHEAPSIZE)-2*SZ_MEMBLOCK;
-        LASTBLOCK->next = NULL;
-        LASTBLOCK->prev = FIRSTBLOCK;
-        LASTBLOCK->tag = TH_FREE_TAG;
-        LASTBLOCK->size = 0;
+        TH_setnext(FIRSTBLOCK, LASTBLOCK);
+        TH_setprev(FIRSTBLOCK, NULL);
+        TH_settag(FIRSTBLOCK, TH_FREE_TAG);
+        FIRSTBLOCK->slack = 0;
+        TH_setnext(LASTBLOCK, NULL);
+        TH_setprev(LASTBLOCK, FIRSTBLOCK);
+        TH_settag(LASTBLOCK, TH_FREE_TAG);
+        LASTBLOCK->slack = 0;
         #if TH_CANARY_ENABLED == 1
         // Fill in canary values
         for (int i=0; i<4; i++) {
@@ -44,8 +195,12 @@ void TH_init() {
             LASTBLOCK->canary[i] = 0xDEADBEEF;  
         }
         #endif
+        link_free(FIRSTBLOCK);
         tag ^= 0x80000000; // Toggle between cache and objects
     } while (tag);
+    #if TH_ALLOCTRACE == 1
+    alloctrace = fopen(TH_ALLOCTRACE_FILE,"wb");
+    #endif
 }
 
 
@@ -58,155 +213,159 @@ static inline unsigned nearest4up(unsigned x) {
     return (x + 3) & ~3;
 }
 
-// Allocate *size* bytes and give them the given tag. Start search in bottom
-static uint8_t *alloc_first_fit(int bytesize, uint32_t tag){
-    // Find first block txhat can hold the requested size starting from bottom
-    unsigned size = nearest4up(bytesize); // Align to 4 bytes
-    unsigned searchsize = size; // Make sure to have space for a block header and meaningful data
-    auto block = FIRSTBLOCK;
-    while (block && ((block->tag==TH_FREE_TAG && block->size < searchsize) 
-         || block->tag != TH_FREE_TAG /*|| (!is_tail_or_free(block->tag))*/ )) { // Disable tail check here as this function now allocates in both heaps
-            block = block->next;
-    }
-    // Now block will either point to a suitable free area or be null
-    if (block && block->tag == TH_FREE_TAG) {
-        // Insert a new header above the block and make room for <<size>> bytes
-        // Mark the new header as free memory 
-        if (block->size < size + SZ_MEMBLOCK + 16) {
-            // Not enough space to split the block meaningfully - just allocate whole block and set size correctly
-            block->size = bytesize;
-            block->tag = tag;
-            return (uint8_t *)(block+1);
-        }
-        int newsize = block->size-SZ_MEMBLOCK-size;
-        uint8_t *newptr = (uint8_t *)block + SZ_MEMBLOCK + size;
-        auto newblock = (th_memblock_t *)newptr;
-        block->next->prev = newblock;
-        newblock->next = block->next;
-        newblock->prev = block;
-        block->next=newblock;
-        newblock->size = newsize;
-        // The data is south of the new block
-        newblock->tag = TH_FREE_TAG;
-        block->tag=tag;
-        block->size = bytesize; // may be overallocated
-        #if TH_CANARY_ENABLED == 1
-        // Fill in canary values in the new block
-        for (int i=0; i<4; i++) {
-            newblock->canary[i] = 0xDEADBEEF;
-        }
-        #endif
-        return (uint8_t *)(block+1);
+// Find a free block that can hold size bytes. Every block in a class above the class of size is
+// big enough, so the head of the first of those is taken. Only when there is none are the
+// blocks in the class of size itself searched. Either way the choice depends on the order of
+// the lists rather than on addresses, which keeps allocation from walking them.
+static th_memblock_t *find_fit(int heap, unsigned size) {
+    int sc = sizeclass(size);
+    uint32_t above = freeclasses[heap] & ~((2u << sc) - 1);
+    if (above) return freelist[heap][__builtin_ctz(above)];
+    for (auto block = freelist[heap][sc]; block; block = freelink(block)->next) {
+        if (TH_size(block) >= size) return block;
     }
     return NULL;
 }
 
-// Allocate *size* bytes and give them the given tag. Start search in bottom
-static uint8_t *alloc_best_fit(int bytesize, uint32_t tag){
-    // Find first block txhat can hold the requested size starting from bottom
+// Allocate *size* bytes from the free block *block* and give them the given tag
+static uint8_t *alloc_from(th_memblock_t *block, int bytesize, uint32_t tag){
     unsigned size = nearest4up(bytesize); // Align to 4 bytes
-    unsigned searchsize = size + SZ_MEMBLOCK + 16; // Make sure to have space for a block header and meaningful data
-    auto block = FIRSTBLOCK;
-    th_memblock_t *bestblock = NULL;
-    while (block) {
-        if (block->tag == TH_FREE_TAG && block->size >= searchsize) {
-            if (!bestblock || block->size < bestblock->size) {
-                bestblock = block;
-            }
-        }
-        block = block->next;
-    }
-    block = bestblock;
-    // Now block will either point to a suitable free area or be null
-    if (block && block->tag == TH_FREE_TAG) {
-        // Insert a new header above the block and make room for <<size>> bytes
-        // Mark the new header as free memory 
-        if (block->size < size + SZ_MEMBLOCK + 16) {
-            // Not enough space to split the block meaningfully - just allocate whole block and set size correctly
-            block->size = bytesize;
-            block->tag = tag;
-            return (uint8_t *)(block+1);
-        }
-        int newsize = block->size-SZ_MEMBLOCK-size;
-        uint8_t *newptr = (uint8_t *)block + SZ_MEMBLOCK + size;
-        auto newblock = (th_memblock_t *)newptr;
-        block->next->prev = newblock;
-        newblock->next = block->next;
-        newblock->prev = block;
-        block->next=newblock;
-        newblock->size = newsize;
-        // The data is south of the new block
-        newblock->tag = TH_FREE_TAG;
-        block->tag=tag;
-        block->size = bytesize; // may be overallocated
-        #if TH_CANARY_ENABLED == 1
-        // Fill in canary values in the new block
-        for (int i=0; i<4; i++) {
-            newblock->canary[i] = 0xDEADBEEF;
-        }
-        #endif
+    unlink_free(block);
+    // Insert a new header above the block and make room for <<size>> bytes
+    // Mark the new header as free memory 
+    if (TH_size(block) < size + SZ_MEMBLOCK + 16) {
+        // Not enough space to split the block meaningfully - just allocate whole block and set size correctly
+        TH_setsize(block, bytesize);
+        TH_settag(block, tag);
         return (uint8_t *)(block+1);
     }
-    return NULL;
+    uint8_t *newptr = (uint8_t *)block + SZ_MEMBLOCK + size;
+    auto newblock = (th_memblock_t *)newptr;
+    TH_setprev(TH_next(block), newblock);
+    TH_setnext(newblock, TH_next(block));
+    TH_setprev(newblock, block);
+    TH_setnext(block, newblock);
+    newblock->slack = 0;
+    // The data is south of the new block
+    TH_settag(newblock, TH_FREE_TAG);
+    TH_settag(block, tag);
+    TH_setsize(block, bytesize); // may be overallocated
+    #if TH_CANARY_ENABLED == 1
+    // Fill in canary values in the new block
+    for (int i=0; i<4; i++) {
+        newblock->canary[i] = 0xDEADBEEF;
+    }
+    #endif
+    link_free(newblock);
+    return (uint8_t *)(block+1);
 }
 
-uint8_t *TH_alloc(int bytesize, uint32_t tag) {
+// Allocate *size* bytes and give them the given tag, allowing the block to be used up exactly
+static uint8_t *alloc_any_fit(int bytesize, uint32_t tag){
+    unsigned size = nearest4up(bytesize); // Align to 4 bytes
+    auto block = find_fit(tag >> 31, size);
+    return block ? alloc_from(block, bytesize, tag) : NULL;
+}
+
+// Allocate *size* bytes and give them the given tag, from a block that can also be split
+static uint8_t *alloc_split_fit(int bytesize, uint32_t tag){
+    unsigned size = nearest4up(bytesize); // Align to 4 bytes
+    unsigned searchsize = size + SZ_MEMBLOCK + 16; // Make sure to have space for a block header and meaningful data
+    auto block = find_fit(tag >> 31, searchsize);
+    return block ? alloc_from(block, bytesize, tag) : NULL;
+}
+
+static int freeblock(th_memblock_t *block);
+
+// The API entry points below record themselves in the trace, so they call these rather than each other
+static uint8_t *alloc_tagged(int bytesize, uint32_t tag) {
     #if TH_CANARY_ENABLED == 1
     printf("TH_alloc: Requesting %d bytes with tag %u (%s)\n", bytesize, tag, is_tail_or_free(tag) ? "objects" : "cache");
     #endif
-    auto ptr = (tag) ? alloc_best_fit(bytesize,tag) : alloc_first_fit(bytesize,tag); ;
+    #if TH_COMPACT_HEADER == 1
+    assert((tag & 0x7fff8000) == 0); // Only 15 bits and the tail bit fit in a compact header
+    #endif
+    if (is_tail_or_free(tag)) {
+        // Make room for the tag list links behind the data
+        auto ptr = alloc_split_fit(bytesize+SZ_TAGLINK,tag);
+        if (ptr) {
+            th_memblock_t *block = (th_memblock_t *)(ptr) - 1;
+            TH_setsize(block, bytesize);
+            link_tag(block);
+        }
+        return ptr;
+    }
+    auto ptr = (tag) ? alloc_split_fit(bytesize,tag) : alloc_any_fit(bytesize,tag); ;
     return ptr;
 }
 
-uint8_t *TH_realloc(uint8_t *ptr, int newsize) {
+uint8_t *TH_alloc(int bytesize, uint32_t tag) {
+    auto ptr = alloc_tagged(bytesize, tag);
+    TRACE_ALLOC(TH_TRACE_ALLOC, tag, bytesize, NULL, ptr);
+    return ptr;
+}
+
+static uint8_t *realloc_block(uint8_t *ptr, int newsize) {
     int newsize_aligned = nearest4up(newsize);
     if (!ptr) return NULL;
+    th_memblock_t *block = (th_memblock_t *)(ptr) - 1;
     if (newsize <= 0) {
-        TH_free(ptr);
+        freeblock(block);
         return NULL;
     }
-    th_memblock_t *block = (th_memblock_t *)(ptr) - 1;
-    if (block->size >= (uint32_t)newsize) {
+    if (TH_size(block) >= (uint32_t)newsize) {
         // Already big enough  
         return ptr;
     } else {
+        // Object blocks keep their tag list links at the end, and they must move with it
+        bool tagged = is_tail_or_free(TH_tag(block));
+        th_taglink_t link = {0, 0};
+        if (tagged) {
+            link = *taglink(block);
+            newsize_aligned = nearest4up(newsize + SZ_TAGLINK);
+        }
         // Find out if we can expand into next block
-        th_memblock_t *next = block->next;
-        if (next->tag == TH_FREE_TAG && (block->size + SZ_MEMBLOCK + next->size) >= (uint32_t)newsize_aligned) {
-            // Can expand here
-            int extra_needed = newsize_aligned - block->size;
+        th_memblock_t *next = TH_next(block);
+        if (TH_tag(next) == TH_FREE_TAG && (TH_capacity(block) + SZ_MEMBLOCK + TH_size(next)) >= (uint32_t)newsize_aligned) {
+            // Can expand here - counting from the capacity so the moved header stays word aligned
+            int extra_needed = newsize_aligned - TH_capacity(block);
             // CHeck if we leave a reasonable block size behind if we split
             // We are only moving the next block header up so no need to account for 
             // that blocksize
-            if (next->size > (uint32_t)extra_needed + 16) {
+            // The header of next moves or goes away
+            if (next == defragcursor) defragcursor = NULL;
+            unlink_free(next);
+            if (TH_size(next) > (uint32_t)extra_needed + 16) {
                 // Split the next block
                 uint8_t *newblockptr = (uint8_t *)(next) + extra_needed;
                 th_memblock_t *newblock = (th_memblock_t *)newblockptr;
-                newblock->tag = TH_FREE_TAG;
-                newblock->size = next->size - extra_needed;
-                newblock->next = next->next;
-                newblock->prev = block;
-                next->next->prev = newblock;
-                block->next = newblock;
-                block->size = newsize;
+                TH_settag(newblock, TH_FREE_TAG);
+                newblock->slack = 0;
+                TH_setnext(newblock, TH_next(next));
+                TH_setprev(newblock, block);
+                TH_setprev(TH_next(next), newblock);
+                TH_setnext(block, newblock);
+                TH_setsize(block, newsize);
+                link_free(newblock);
             } else {
                 // Just take the whole next block
-                block->size = newsize; // May be overallocated - but that's ok
-                block->next = next->next;
-                next->next->prev = block;   
+                TH_setnext(block, TH_next(next));
+                TH_setprev(TH_next(block), block);
+                TH_setsize(block, newsize); // May be overallocated - but that's ok
             }
+            if (tagged) *taglink(block) = link;
             return ptr;
         } else {
             // Need to allocate a new block and move data
-            uint8_t *newptr = TH_alloc(newsize, block->tag);
+            uint8_t *newptr = alloc_tagged(newsize, TH_tag(block));
             if (newptr) {
                 // Copy old data
                 uint8_t *src = ptr;
                 uint8_t *dst = newptr;
-                for (unsigned n=0; n<block->size; n++) {
+                for (unsigned n=0; n<TH_size(block); n++) {
                     *dst++ = *src++;
                 }
-                TH_free(ptr);
+                freeblock(block);
                 return newptr;
             }
         }
@@ -214,15 +373,36 @@ uint8_t *TH_realloc(uint8_t *ptr, int newsize) {
     return NULL;
 }
 
+uint8_t *TH_realloc(uint8_t *ptr, int newsize) {
+    #if TH_ALLOCTRACE == 1
+    uint32_t tag = ptr ? TH_tag((th_memblock_t *)(ptr) - 1) : 0;
+    #endif
+    auto newptr = realloc_block(ptr, newsize);
+    TRACE_ALLOC(TH_TRACE_REALLOC, tag, newsize, ptr, newptr);
+    return newptr;
+}
+
 static int freeblock(th_memblock_t *block){
-    th_memblock_t *next = block->next;
-    th_memblock_t *prev = block->prev;
+    th_memblock_t *next = TH_next(block);
+    th_memblock_t *prev = TH_prev(block);
     int freetype = 0;
+    // Merging removes the headers of block and next, and space freed below the cursor 
+    // would be missed by the rest of the pass
+    if (block <= defragcursor) defragcursor = NULL;
     // Allow merge with next block only if it is not the end marker
-    freetype |= (next && next->tag == TH_FREE_TAG && next->size > 0) ? 1 : 0;
-    freetype |= (prev && prev->tag == TH_FREE_TAG) ? 2 : 0;
+    freetype |= (next && TH_tag(next) == TH_FREE_TAG && TH_size(next) > 0) ? 1 : 0;
+    freetype |= (prev && TH_tag(prev) == TH_FREE_TAG) ? 2 : 0;
 
-    int freed = block->size;
+    // Freeing a block that is already free only merges it again, so it must not be listed twice
+    if (TH_tag(block) == TH_FREE_TAG) {
+        unlink_free(block);
+    } else if (is_tail_or_free(TH_tag(block))) {
+        unlink_tag(block);
+    }
+    if (freetype & 1) unlink_free(next);
+    if (freetype & 2) unlink_free(prev);
+
+    int freed = TH_size(block);
     // Compute how many memblock allocations we save below
     for (int i=freetype; i ; i>>=1) {
         freed += SZ_MEMBLOCK;
@@ -230,81 +410,113 @@ static int freeblock(th_memblock_t *block){
     switch (freetype) {
         case 0: // block is a new free island
         #if TH_CANARY_ENABLED == 1
-            printf("Freeing block at %p of size %u creating an island\n", (void *)block, block->size);
+            printf("Freeing block at %p of size %u creating an island\n", (void *)block, TH_size(block));
         #endif
-            block->tag = TH_FREE_TAG;
+            TH_settag(block, TH_FREE_TAG);
             break;
         case 1: // Merge with next, removing next block - unless it is next-to-last block
         #if TH_CANARY_ENABLED == 1
-            printf("Freeing block at %p of size %u merging with next block at %p of size %u\n", (void *)block, block->size, (void *)next, next->size);
+            printf("Freeing block at %p of size %u merging with next block at %p of size %u\n", (void *)block, TH_size(block), (void *)next, TH_size(next));
         #endif
-            //block->size += next->size+SZ_MEMBLOCK;
-            block->next = next->next;
-            next->next->prev = block;
-            block->tag = TH_FREE_TAG;
+            TH_setnext(block, TH_next(next));
+            TH_setprev(TH_next(next), block);
+            TH_settag(block, TH_FREE_TAG);
             break;
         case 2: // Merge with previous, removing this block
         #if TH_CANARY_ENABLED == 1
-            printf("Freeing block at %p of size %u merging with previous block at %p of size %u\n", (void *)block, block->size, (void *)prev, prev->size);
+            printf("Freeing block at %p of size %u merging with previous block at %p of size %u\n", (void *)block, TH_size(block), (void *)prev, TH_size(prev));
         #endif
-            //prev->size += block->size + SZ_MEMBLOCK;
-            prev->next = block->next;
-            next->prev = prev;
+            TH_setnext(prev, TH_next(block));
+            TH_setprev(next, prev);
             block = prev;
             break;
         case 3: // Merge block and next with previous
         #if TH_CANARY_ENABLED == 1
-            printf("Freeing block at %p of size %u merging with previous block at %p of size %u and next block at %p of size %u\n", (void *)block, block->size, (void *)prev, prev->size, (void *)next, next->size);
+            printf("Freeing block at %p of size %u merging with previous block at %p of size %u and next block at %p of size %u\n", (void *)block, TH_size(block), (void *)prev, TH_size(prev), (void *)next, TH_size(next));
         #endif
-            //prev->size += block->size + next->size + 2*SZ_MEMBLOCK;
-            prev->next = next->next;
-            next->next->prev = prev;
+            TH_setnext(prev, TH_next(next));
+            TH_setprev(TH_next(next), prev);
             block = prev;
             break;
         default:
             break;
     }
-    // Adjust the size of the resulting free block
-    block->size = (uintptr_t)(block->next) - (uintptr_t)(block+1);
+    // The resulting free block is free all the way up to the next one
+    block->slack = 0;
+    link_free(block);
     return freed;
 }
 
 // Free all blocks with tags between tag_low and tag_high both included.
 void TH_freetags(uint32_t tag_low, uint32_t tag_high){
+    TH_freetags_cb(tag_low, tag_high, NULL);
+}
+
+// As TH_freetags, but call back with each block before any of them is freed
+void TH_freetags_cb(uint32_t tag_low, uint32_t tag_high, freetags_cb_t callback){
     assert (is_tail_or_free(tag_low) == is_tail_or_free(tag_high)); // Must be same type of tags
+    TRACE_ALLOC(TH_TRACE_FREETAGS, tag_low, tag_high, NULL, NULL);
     unsigned tag = tag_low;
-    auto block = FIRSTBLOCK;
-    while (block) {
-        if (tag_low <= block->tag && block->tag <= tag_high) {
-            freeblock(block);
+    if (!is_tail_or_free(tag)) {
+        // Cache blocks aren't listed by tag, so walk all of them
+        auto block = FIRSTBLOCK;
+        if (callback) {
+            for (auto b = block; b; b = TH_next(b)) {
+                if (tag_low <= TH_tag(b) && TH_tag(b) <= tag_high) callback((uint8_t *)(b+1));
+            }
+        }
+        while (block) {
+            if (tag_low <= TH_tag(block) && TH_tag(block) <= tag_high) {
+                freeblock(block);
+            }
+            block = TH_next(block);
+        }
+        return;
+    }
+    for (int tc = tagclass(tag_low); tc <= tagclass(tag_high); tc++) {
+        if (callback) {
+            for (auto block = taglist[tc]; block; block = tagderef(taglink(block)->next)) {
+                if (tag_low <= TH_tag(block) && TH_tag(block) <= tag_high) callback((uint8_t *)(block+1));
+            }
+        }
+        auto block = taglist[tc];
+        while (block) {
+            // Freeing unlinks the block, so step on first
+            auto next = tagderef(taglink(block)->next);
+            if (tag_low <= TH_tag(block) && TH_tag(block) <= tag_high) {
+                freeblock(block);
+            }
+            block = next;
         }
-        block = block->next;
     }
 }
 
 // Free a single block pointed to by ptr
 int TH_free(uint8_t *ptr){
     th_memblock_t *block = (th_memblock_t *)ptr;
+    TRACE_ALLOC(TH_TRACE_FREE, TH_tag(block-1), 0, ptr, NULL);
     return freeblock(block-1);
 }
 
-// Defrag cache as described in tagheap.h. Both tag_low and tag_high is included
-// in the range to be defragmented. Never set tag_high to TH_FREE_TAG
-void TH_defrag(defrag_cb_t move_if_allowed){
+// Defrag cache as described in tagheap.h, continuing from where the last call stopped
+// and stopping once maxbytes have been moved. Returns true when the pass is complete.
+static bool defrag_step(defrag_cb_t move_if_allowed, int maxbytes){
     unsigned tag = 0; // Only cache head blocks
-    auto block = FIRSTBLOCK;
-    // TODO: Implement defragmentation
+    auto block = defragcursor ? defragcursor : FIRSTBLOCK;
+    int moved = 0;
     while (block) {
-        if (block->tag == TH_FREE_TAG && block->size > 0){
-            if (block->next->tag == TH_FREE_TAG) {
+        if (TH_tag(block) == TH_FREE_TAG && TH_size(block) > 0){
+            if (TH_tag(TH_next(block)) == TH_FREE_TAG) {
                 // Reconcile the two blocks unless we reached the end
-                if (block->next->size > 0) {
+                if (TH_size(TH_next(block)) > 0) {
                     #if TH_CANARY_ENABLED == 1
-                    printf("Defrag: Merging free block at %p of size %u with next free block at %p of size %u\n", (void *)block, block->size, (void *)(block->next), block->next->size);
+                    printf("Defrag: Merging free block at %p of size %u with next free block at %p of size %u\n", (void *)block, TH_size(block), (void *)(TH_next(block)), TH_size(TH_next(block)));
                     #endif
-                    block->size += block->next->size + SZ_MEMBLOCK;
-                    block->next = block->next->next;
-                    block->next->prev = block;
+                    unlink_free(block);
+                    unlink_free(TH_next(block));
+                    TH_setnext(block, TH_next(TH_next(block)));
+                    TH_setprev(TH_next(block), block);
+                    link_free(block);
                     // Retry the move
                     continue;
                 } else {
@@ -313,39 +525,44 @@ void TH_defrag(defrag_cb_t move_if_allowed){
                 }
             } else {
                 // We may have a block we can move ... 
-                th_memblock_t *next = block->next;
+                th_memblock_t *next = TH_next(block);
                 // We are into the objects - no need to continue defrag
-                if (is_tail_or_free(next->tag)) break;
-                // Else check if we can move it
+                if (is_tail_or_free(TH_tag(next))) break;
+                // Else check if we can move it - within the budget, but always at least one
+                unsigned realsize = (TH_size(next) +3) & ~3; // Align to 4 bytes
+                if (moved > 0 && moved + realsize > (unsigned)maxbytes) {
+                    defragcursor = block;
+                    return false;
+                }
                 uint8_t *newaddr = (uint8_t *)(block+1);
-                if (move_if_allowed(next->tag,newaddr)){
+                if (move_if_allowed(TH_tag(next),newaddr)){
                     #if TH_CANARY_ENABLED == 1
-                    printf ("Defrag: Moving block with tag %u from %p to %p\n", next->tag, (void *)(next), (void *)newaddr);
+                    printf ("Defrag: Moving block with tag %u from %p to %p\n", TH_tag(next), (void *)(next), (void *)newaddr);
                     #endif
-                    // Move allowed
-                    th_memblock_t oldblock = *next;
+                    // Move allowed - the data goes where the links of block are
+                    unlink_free(block);
+                    th_memblock_t *oldnext = TH_next(next);
+                    uint32_t oldtag = TH_tag(next);
+                    uint32_t oldsize = TH_size(next);
+                    TRACE_ALLOC(TH_TRACE_MOVE, oldtag, oldsize, (uint8_t *)(next+1), newaddr);
                     // We can move using 32 bit load/stores as we know everything is 4 uint8_t aligned
                     uint32_t *dst = (uint32_t *)newaddr;
                     uint32_t *src = (uint32_t *)(next+1);
-                    unsigned realsize = (next->size +3) & ~3; // Align to 4 bytes
                     for (unsigned n=0; n<(realsize>>2); n++) {
                         *dst++=*src++;
                     }
+                    moved += realsize;
                     // We are effectively flipping the free space in block 
                     // with the data area in block->next, so the sizes and 
                     // tags of the two swaps. We then insert a new block after the 
                     // new data area that holds the new free space. Consolidation
                     // with eventual free space will be done next round. 
                     th_memblock_t *newblock = (th_memblock_t *)dst;
-                    newblock->size = block->size; 
-                    #if TH_CANARY_ENABLED == 1
-                    uintptr_t avail = (uintptr_t)(oldblock.next) - (uintptr_t)(newblock+1);
-                    assert(newblock->size <= avail);
-                    #endif
-                    newblock->tag = TH_FREE_TAG;
-                    // Tying up the pointers in block and newblock + oldblock.next
-                    newblock->next = oldblock.next;
-                    newblock->next->prev = newblock;
+                    newblock->slack = 0;
+                    TH_settag(newblock, TH_FREE_TAG);
+                    // Tying up the links in block and newblock + the old next
+                    TH_setnext(newblock, oldnext);
+                    TH_setprev(oldnext, newblock);
                     #if TH_CANARY_ENABLED == 1
                     // Fill in canary values in the new block
                     for (int i=0; i<4; i++) {
@@ -353,18 +570,33 @@ void TH_defrag(defrag_cb_t move_if_allowed){
                     }
                     #endif
                     // Update moved block header
-                    block->tag = oldblock.tag;
-                    block->size = oldblock.size;
-                    block->next = newblock;
-                    newblock->prev = block;
+                    TH_settag(block, oldtag);
+                    TH_setnext(block, newblock);
+                    TH_setsize(block, oldsize);
+                    TH_setprev(newblock, block);
+                    link_free(newblock);
                 }
             }
         } else {
             // We are into the objects - no need to terminate defrag
-            if (is_tail_or_free(block->tag)) break;
+            if (is_tail_or_free(TH_tag(block))) break;
         }
-        block = block->next;
+        block = TH_next(block);
     }
+    defragcursor = NULL;
+    return true;
+}
+
+bool TH_defrag_step(defrag_cb_t move_if_allowed, int maxbytes){
+    TRACE_ALLOC(TH_TRACE_DEFRAGSTEP, 0, maxbytes, NULL, NULL);
+    return defrag_step(move_if_allowed, maxbytes);
+}
+
+// Defrag the whole cache in one go
+void TH_defrag(defrag_cb_t move_if_allowed){
+    TRACE_ALLOC(TH_TRACE_DEFRAG, 0, 0, NULL, NULL);
+    defragcursor = NULL;
+    defrag_step(move_if_allowed, TH_CACHEHEAPSIZE);
 }
 
 int TH_countfreehead() {
@@ -373,18 +605,40 @@ int TH_countfreehead() {
     int free = 0;
     // Step through and find all free blocks until we meet a objects block or reach the end
     while (block) {
-        if (block->tag == TH_FREE_TAG) {
-            free += block->size;
+        if (TH_tag(block) == TH_FREE_TAG) {
+            free += TH_size(block);
         } else {
-            if (is_tail_or_free(block->tag)) {
+            if (is_tail_or_free(TH_tag(block))) {
                 break;
             }
         }
-        block = block->next;
+        block = TH_next(block);
     }
     return free;
 }
 
+int TH_snapshot(th_blockinfo_t *blocks, int maxblocks, snapshot_cb_t callback) {
+    unsigned tag = 0;
+    int count = 0;
+    do {
+        // The end marker holds nothing, so it is left out
+        for (auto block = FIRSTBLOCK; TH_next(block); block = TH_next(block)) {
+            if (count < maxblocks) {
+                th_blockinfo_t *info = &blocks[count];
+                info->offset = (uint32_t)((uint8_t *)(block+1) - th_heap);
+                info->size = TH_size(block);
+                info->tag = TH_tag(block);
+                info->lump = -1;
+                info->flags = 0;
+                if (callback && info->tag != TH_FREE_TAG) callback((uint8_t *)(block+1), info);
+            }
+            count++;
+        }
+        tag ^= 0x80000000;
+    } while (tag);
+    return count;
+}
+
 bool TH_checkhealth_verbose() {
     #if TH_CANARY_ENABLED != 1
     return true;
@@ -403,28 +657,28 @@ bool TH_checkhealth_verbose() {
             // Check canary values
             for (int i=0; i<4; i++) {
                 if (block->canary[i] != 0xDEADBEEF) {
-                    printf("WARNING: Block #%d with tag %d has corrupted canary value at index %d\n", cnt, block->tag, i);
+                    printf("WARNING: Block #%d with tag %d has corrupted canary value at index %d\n", cnt, TH_tag(block), i);
                     healthy = false;                
                 }
             }
             #endif
             // Check backward link consistency
-            if (block->prev != prev) {
-                printf("WARNING: Block chain broken at block #%d with tag %d: backward link inconsistency - expected %p got %p. Previous block had tag %d\n", cnt, block->tag, (void *)prev, (void *)block->prev, prev ? prev->tag : -1);
+            if (TH_prev(block) != prev) {
+                printf("WARNING: Block chain broken at block #%d with tag %d: backward link inconsistency - expected %p got %p. Previous block had tag %d\n", cnt, TH_tag(block), (void *)prev, (void *)TH_prev(block), prev ? TH_tag(prev) : -1);
                 healthy = false;
             }
-            if (block->next && ((uint8_t *)block->next < th_heap || 
-                (uint8_t *)block->next >= th_heap + TH_HEAPSIZE)) {
-                printf("WARNING: Block chain broken at block #%d  with tag %d: next pointer out of bounds\n", cnt, block->tag);
+            if (TH_next(block) && ((uint8_t *)TH_next(block) < th_heap || 
+                (uint8_t *)TH_next(block) >= th_heap + TH_HEAPSIZE)) {
+                printf("WARNING: Block chain broken at block #%d  with tag %d: next pointer out of bounds\n", cnt, TH_tag(block));
                 healthy = false;
                 break;
             }
-            if (block->tag == TH_FREE_TAG) {
-                freemem += block->size;
-                contigfree = (contigfree > block->size) ? contigfree : block->size;
+            if (TH_tag(block) == TH_FREE_TAG) {
+                freemem += TH_size(block);
+                contigfree = (contigfree > TH_size(block)) ? contigfree : TH_size(block);
             }
             prev = block;
-            block = block->next;
+            block = TH_next(block);
             cnt++;
         }
         if (healthy) {
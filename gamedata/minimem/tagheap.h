@@ -30,9 +30,13 @@
 
 
 // Heap size in 32-bit words
-#ifndef TH_HEAPSIZE
+#ifndef TH_CACHEHEAPSIZE
 #define TH_CACHEHEAPSIZE 180000 // bytes - portion of heap used for caching
+#endif
+#ifndef TH_OBJECTHEAPSIZE
 #define TH_OBJECTHEAPSIZE 220000 // bytes - portion of heap used for static and level objects
+#endif
+#ifndef TH_HEAPSIZE
 #define TH_HEAPSIZE (TH_CACHEHEAPSIZE+TH_OBJECTHEAPSIZE)
 #endif
 
@@ -43,35 +47,156 @@
 #if TH_CANARY_ENABLED == 1
 #include <stdio.h>
 #endif
+/**
+ * Block headers link to the neighbouring blocks by their distance in 32 bit words, and keep
+ * the number of bytes at the end of the block that weren't asked for instead of the size.
+ * With compact headers these are 16 bit and so is the tag (bit 15 is the tail bit), which
+ * makes a header 8 bytes. No block, and so no heap, can then be more than 256 KB. Bigger heaps
+ * get 32 bit fields and 16 byte headers.
+ * 
+ * Go through the TH_ accessors below rather than the fields.
+ */
+#ifndef TH_COMPACT_HEADER
+#if TH_CACHEHEAPSIZE < 0x40000 && TH_OBJECTHEAPSIZE < 0x40000
+#define TH_COMPACT_HEADER 1
+#else
+#define TH_COMPACT_HEADER 0
+#endif
+#endif
+
+#if TH_COMPACT_HEADER == 1
+#if TH_CACHEHEAPSIZE >= 0x40000 || TH_OBJECTHEAPSIZE >= 0x40000
+#error "Compact block headers can't link blocks more than 256 KB apart"
+#endif
+typedef uint16_t th_field_t;
+#else
+typedef uint32_t th_field_t;
+#endif
+
 typedef struct th_memblock_s {
     #if TH_CANARY_ENABLED == 1
     uint32_t canary[4]; // Canary to detect memory corruption
     #endif
-    struct th_memblock_s *prev;
-    struct th_memblock_s *next;
-    uint32_t tag;   // Tag of this block
-    uint32_t size;  // Size in bytes
+    th_field_t prev;    // Words down to the previous block, 0 for the first block
+    th_field_t next;    // Words up to the next block, 0 for the end marker
+    th_field_t tag;     // Tag of this block
+    th_field_t slack;   // Bytes at the end of the block beyond the size asked for
 } th_memblock_t;
 
+// Allocated blocks in the object heap also keep two tag list links behind their data
+#define TH_TAGLINKSIZE (2*sizeof(th_field_t))
+
 extern uint8_t th_heap[TH_HEAPSIZE];
 #define FIRSTBLOCK ((th_memblock_t *)&th_heap[0+(tag >> 31)*TH_CACHEHEAPSIZE])
 
 #define TH_FREE_TAG 0xffffffff
 
+static inline th_memblock_t *TH_next(const th_memblock_t *block) {
+    return block->next ? (th_memblock_t *)((uint32_t *)block + block->next) : nullptr;
+}
+
+static inline th_memblock_t *TH_prev(const th_memblock_t *block) {
+    return block->prev ? (th_memblock_t *)((uint32_t *)block - block->prev) : nullptr;
+}
+
+static inline void TH_setnext(th_memblock_t *block, const th_memblock_t *next) {
+    block->next = next ? (th_field_t)(((const uint8_t *)next - (const uint8_t *)block) >> 2) : 0;
+}
+
+static inline void TH_setprev(th_memblock_t *block, const th_memblock_t *prev) {
+    block->prev = prev ? (th_field_t)(((const uint8_t *)block - (const uint8_t *)prev) >> 2) : 0;
+}
+
+// Bytes between the header and the next block
+static inline uint32_t TH_capacity(const th_memblock_t *block) {
+    return block->next ? block->next*4 - sizeof(th_memblock_t) : 0;
+}
+
+// Size in bytes as asked for - which for free blocks is all of it. Set the next block first.
+static inline uint32_t TH_size(const th_memblock_t *block) {
+    return TH_capacity(block) - block->slack;
+}
+
+static inline void TH_setsize(th_memblock_t *block, uint32_t size) {
+    block->slack = (th_field_t)(TH_capacity(block) - size);
+}
+
+static inline uint32_t TH_tag(const th_memblock_t *block) {
+    #if TH_COMPACT_HEADER == 1
+    if (block->tag == 0xffff) return TH_FREE_TAG;
+    return (block->tag & 0x7fff) | ((block->tag & 0x8000) << 16);
+    #else
+    return block->tag;
+    #endif
+}
+
+static inline void TH_settag(th_memblock_t *block, uint32_t tag) {
+    #if TH_COMPACT_HEADER == 1
+    block->tag = (th_field_t)((tag & 0x7fff) | ((tag >> 16) & 0x8000));
+    #else
+    block->tag = tag;
+    #endif
+}
+
 
 typedef bool (*defrag_cb_t)(short tag, uint8_t *proposed_newptr);
 
 uint8_t *TH_alloc(int bytesize, uint32_t tag);
 uint8_t *TH_realloc(uint8_t *ptr, int newsize);
 void TH_freetags(uint32_t tag_low, uint32_t tag_high);
+// As TH_freetags, but first calls back with the data of every block that is about to be freed.
+// Tail tags only visit the blocks with the tags in the range.
+typedef void (*freetags_cb_t)(uint8_t *ptr);
+void TH_freetags_cb(uint32_t tag_low, uint32_t tag_high, freetags_cb_t callback);
 // Return the amount of bytes freed by this free (including headers)
 int TH_free(uint8_t *ptr);
 void TH_defrag(defrag_cb_t callback);
+// Incremental defrag: moves at most maxbytes (but at least one block) and then returns, 
+// continuing where it stopped on the next call. Returns true when a full pass is done.
+bool TH_defrag_step(defrag_cb_t callback, int maxbytes);
 void TH_init();
 // Count how many bytes are free for allocation into head.
 int TH_countfreehead();
 
 bool TH_checkhealth_verbose();
 
+// Heap map: one record per block of both heaps, cache heap first and lowest address first.
+// The heap only knows where blocks are and their tags - the callback, if given, is called for
+// every allocated block to fill in what the owner knows about it.
+typedef struct th_blockinfo_s {
+    uint32_t offset;  // Offset of the block data in th_heap
+    uint32_t size;    // Bytes asked for, or free bytes
+    uint32_t tag;     // TH_FREE_TAG for free blocks
+    int16_t lump;     // Lump held by the block, -1 if none
+    uint16_t flags;   // TH_BLOCK_ flags below
+} th_blockinfo_t;
+
+#define TH_BLOCK_PINNED 1 // Can't be moved or evicted right now
+
+typedef void (*snapshot_cb_t)(uint8_t *ptr, th_blockinfo_t *info);
+// Fill in at most maxblocks records. Returns the number of blocks, which may be more.
+int TH_snapshot(th_blockinfo_t *blocks, int maxblocks, snapshot_cb_t callback);
+
+// Record of the allocation trace written by heaps built with TH_ALLOCTRACE=1. There is one
+// record per API call, with addresses as byte offsets of the data into th_heap (TH_TRACE_NULL
+// for NULL). A defrag call is followed by a TH_TRACE_MOVE record for every block it moved.
+typedef struct {
+    uint32_t op;
+    uint32_t tag;     // Tag asked for or of the block, low tag for TH_freetags
+    uint32_t size;    // Bytes asked for or moved, high tag for TH_freetags, maxbytes for TH_defrag_step
+    uint32_t ptr;     // Block passed in, or where a moved block was
+    uint32_t result;  // Block returned, or where a moved block went
+} th_tracerecord_t;
+
+#define TH_TRACE_NULL 0xffffffff
+
+#define TH_TRACE_ALLOC 'A'      // TH_alloc
+#define TH_TRACE_REALLOC 'R'    // TH_realloc
+#define TH_TRACE_FREE 'F'       // TH_free
+#define TH_TRACE_FREETAGS 'T'   // TH_freetags and TH_freetags_cb
+#define TH_TRACE_DEFRAG 'D'     // TH_defrag
+#define TH_TRACE_DEFRAGSTEP 'S' // TH_defrag_step
+#define TH_TRACE_MOVE 'M'       // A block moved by defrag
+
 
 #endif // __memheap_h
\ No newline at end of file
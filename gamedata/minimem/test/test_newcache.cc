@@ -0,0 +1,271 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include "../../../newcache/newcache.h"
+#include "../../../include/r_defs.h"
+#include "../wadreader.h"
+#include "../tagheap.h"
+
+// Epochs only hold lumps after this many epochs without evictions (set for ../w_nc.cc in the Makefile)
+#ifndef NC_EPOCH_CALM
+#define NC_EPOCH_CALM 32
+#endif
+
+// Lumps used in this many tics before a level change stay cached (as in ../w_nc.cc)
+#ifndef NC_WARM_TICS
+#define NC_WARM_TICS 35
+#endif
+
+// Color codes for test output
+#define GREEN "\033[0;32m"
+#define RED "\033[0;31m"
+#define YELLOW "\033[1;33m"
+#define BLUE "\033[0;34m"
+#define RESET "\033[0m"
+
+static int test_count = 0;
+static int test_passed = 0;
+static int test_failed = 0;
+
+// Assertion macros
+#define TEST_ASSERT(condition, message) \
+    do { \
+        test_count++; \
+        if (condition) { \
+            test_passed++; \
+            printf(GREEN "✓" RESET " %s\n", message); \
+        } else { \
+            test_failed++; \
+            printf(RED "✗" RESET " %s (line %d)\n", message, __LINE__); \
+        } \
+    } while (0)
+
+#define TEST_ASSERT_EQ(actual, expected, message) \
+    do { \
+        test_count++; \
+        if ((actual) == (expected)) { \
+            test_passed++; \
+            printf(GREEN "✓" RESET " %s (got %ld)\n", message, (long)(actual)); \
+        } else { \
+            test_failed++; \
+            printf(RED "✗" RESET " %s: expected %ld, got %ld (line %d)\n", \
+                   message, (long)(expected), (long)(actual), __LINE__); \
+        } \
+    } while (0)
+
+// Objects that the cache maps permanently
+unsigned char gfx_stbar[1];
+line_t junk;
+
+// The cache reads through the wadreader. Lumps get a pattern that depends on where they are
+// in the WAD, so that a lump that is damaged or moved under a pointer shows.
+void WR_Init()
+{
+}
+
+void WR_Read(uint8_t *dst, int offset, int len)
+{
+    for (int i = 0; i < len; i++)
+        dst[i] = (uint8_t)((offset + i) * 31 + ((offset + i) >> 8));
+}
+
+void WR_ReadV(const wr_request_t *reqs, int count)
+{
+    for (int i = 0; i < count; i++)
+        WR_Read(reqs[i].dst, reqs[i].offset, reqs[i].len);
+}
+
+uint32_t WR_FlashTime()
+{
+    return 0;
+}
+
+// Collect up to max lumps with a size in [minsize,maxsize], skipping those in skip
+static int find_lumps(int minsize, int maxsize, int *lumps, int max, int skip = -1)
+{
+    int n = 0;
+    for (int i = 0; i < WADLUMPS && n < max; i++) {
+        int size = NC_LumpLength(i);
+        if (i != skip && size >= minsize && size <= maxsize)
+            lumps[n++] = i;
+    }
+    return n;
+}
+
+static uint32_t accesses()
+{
+    return NC_GetStats()->hits + NC_GetStats()->misses;
+}
+
+// Run enough empty epochs for the cache to count as calm
+static void settle()
+{
+    for (int i = 0; i <= NC_EPOCH_CALM; i++) {
+        NC_BeginEpoch();
+        NC_EndEpoch();
+    }
+}
+
+// Test Cases
+
+void test_epoch_holds_resident_lump() {
+    printf(YELLOW "\n--- Test: Epoch Holds a Resident Lump ---\n" RESET);
+    NC_Init();
+
+    int held = -1;
+    TEST_ASSERT(find_lumps(512, 2048, &held, 1) == 1, "Found a small lump");
+    const uint8_t *data = NC_CacheLumpNum(held);
+    settle();
+
+    NC_BeginEpoch();
+    const uint8_t *first = NC_EpochPtr(held);
+    TEST_ASSERT(first == data, "Resident lump is held at its address");
+    uint32_t before = accesses();
+    const uint8_t *again = NC_EpochPtr(held);
+    TEST_ASSERT(again == first, "Held lump resolves to the same pointer");
+    TEST_ASSERT_EQ(accesses() - before, 0, "Held lump resolves without a cache access");
+    TEST_ASSERT(NC_EpochHeld(held) == first, "Proxies find the held lump inline");
+    NC_EndEpoch();
+
+    TEST_ASSERT(NC_EpochPtr(held) == nullptr, "Nothing is held outside an epoch");
+}
+
+void test_epoch_refusal_counted_once() {
+    printf(YELLOW "\n--- Test: Refused Epoch Access Is Counted Once ---\n" RESET);
+    NC_Init();
+    settle();
+
+    int lump = -1;
+    TEST_ASSERT(find_lumps(512, 2048, &lump, 1) == 1, "Found a small lump");
+    NC_BeginEpoch();
+    uint32_t before = accesses();
+    TEST_ASSERT(NC_EpochPtr(lump) == nullptr, "Lump that isn't resident is not held");
+    TEST_ASSERT_EQ(accesses() - before, 0, "Refused access is not counted");
+    // The proxies then pin it the normal way
+    NC_Pin(lump);
+    NC_Unpin(lump);
+    TEST_ASSERT_EQ(accesses() - before, 1, "Fallback pin counts the access once");
+    TEST_ASSERT_EQ(NC_GetStats()->misses, 1, "It was a miss");
+    NC_EndEpoch();
+}
+
+void test_defrag_inside_epoch() {
+    printf(YELLOW "\n--- Test: Defragmentation Inside an Epoch ---\n" RESET);
+    NC_Init();
+
+    // A small lump at the bottom of the cache, and medium ones filling most of the rest
+    int held = -1;
+    TEST_ASSERT(find_lumps(512, 2048, &held, 1) == 1, "Found a small lump");
+    const uint8_t *data = NC_CacheLumpNum(held);
+    int fill[64];
+    int nfill = find_lumps(4096, 8192, fill, 64);
+    int filled = 0;
+    int used = 0;
+    while (used < nfill && filled + NC_LumpLength(fill[used]) < TH_CACHEHEAPSIZE * 4 / 5) {
+        filled += NC_LumpLength(fill[used]);
+        NC_CacheLumpNum(fill[used++]);
+    }
+    printf(BLUE "Filled the cache with %d lumps (%d bytes)\n" RESET, used, filled);
+    TEST_ASSERT(used >= 8, "Cache holds enough lumps to fragment");
+    TEST_ASSERT_EQ(NC_GetStats()->evictions, 0, "Nothing evicted while filling");
+    settle();
+
+    NC_BeginEpoch();
+    const uint8_t *ptr = NC_EpochPtr(held);
+    TEST_ASSERT(ptr == data, "Epoch holds the small lump");
+    int len = NC_LumpLength(held);
+    uint8_t *copy = (uint8_t *)malloc(len);
+    memcpy(copy, ptr, len);
+
+    // Use every other medium lump, so the ones between them are evicted first and leave holes
+    const uint8_t *kept[64];
+    for (int i = 1; i < used; i += 2)
+        kept[i] = NC_CacheLumpNum(fill[i]);
+
+    // A lump that doesn't fit in the free space at the top, but does once the holes are joined
+    int big = -1;
+    int room = TH_CACHEHEAPSIZE - filled - len;
+    TEST_ASSERT(find_lumps(room + 1024, room + 8192, &big, 1) == 1, "Found a lump bigger than the free space");
+    uint32_t defrags = NC_GetStats()->defrags;
+    const uint8_t *bigdata = NC_CacheLumpNum(big);
+    printf(BLUE "Loaded %d bytes with %u evictions and %u defrags\n" RESET, NC_LumpLength(big),
+           NC_GetStats()->evictions, NC_GetStats()->defrags - defrags);
+    TEST_ASSERT(bigdata != nullptr, "Big lump loaded inside the epoch");
+    TEST_ASSERT(NC_GetStats()->evictions > 0, "Loading it evicted lumps");
+    TEST_ASSERT(NC_GetStats()->defrags > defrags, "Loading it defragmented the cache");
+
+    int moved = 0;
+    for (int i = 1; i < used; i += 2) {
+        if (NC_CacheLumpNum(fill[i]) != kept[i]) moved++;
+    }
+    printf(BLUE "%d of the lumps in use were moved\n" RESET, moved);
+    TEST_ASSERT(moved > 0, "Defragmentation moved lumps that aren't held");
+    TEST_ASSERT(NC_EpochPtr(held) == ptr, "Held lump is still at the same address");
+    TEST_ASSERT(memcmp(ptr, copy, len) == 0, "Held lump data is intact");
+    TEST_ASSERT(NC_EpochPtr(fill[1]) == nullptr, "Nothing more is held once the epoch has evicted");
+    NC_EndEpoch();
+    free(copy);
+
+    NC_BeginEpoch();
+    TEST_ASSERT(NC_EpochPtr(held) == nullptr, "Nothing is held right after evictions");
+    NC_EndEpoch();
+}
+
+void test_endlevel_keeps_warm_lumps() {
+    printf(YELLOW "\n--- Test: Level Change Keeps Warm Lumps ---\n" RESET);
+    NC_Init();
+
+    int lumps[2] = {-1, -1};
+    TEST_ASSERT(find_lumps(512, 2048, lumps, 2) == 2, "Found two small lumps");
+    NC_CacheLumpNum(lumps[0]);
+    NC_CacheLumpNum(lumps[1]);
+    // Play on for a while, using only the first lump
+    for (int i = 0; i < NC_WARM_TICS + 10; i++) {
+        NC_CacheLumpNum(lumps[0]);
+        NC_LevelTic();
+        NC_EndFrame();
+    }
+    // The intermission draws frames but runs no tics
+    for (int i = 0; i < 10 * NC_WARM_TICS; i++)
+        NC_EndFrame();
+    uint32_t misses = NC_GetStats()->misses;
+    NC_EndLevel();
+    NC_CacheLumpNum(lumps[0]);
+    TEST_ASSERT_EQ(NC_GetStats()->misses - misses, 0, "Lump used at the end of the level is kept");
+    NC_CacheLumpNum(lumps[1]);
+    TEST_ASSERT_EQ(NC_GetStats()->misses - misses, 1, "Lump unused for a while is evicted");
+}
+
+void run_all_tests() {
+    printf(BLUE "\n╔════════════════════════════════════════════╗\n");
+    printf("║       NewCache White Box Test Suite        ║\n");
+    printf("╚════════════════════════════════════════════╝\n" RESET);
+
+    test_epoch_holds_resident_lump();
+    test_epoch_refusal_counted_once();
+    test_defrag_inside_epoch();
+    test_endlevel_keeps_warm_lumps();
+
+    // Print summary
+    printf(BLUE "\n╔════════════════════════════════════════════╗\n");
+    printf("║              Test Summary                   ║\n");
+    printf("╚════════════════════════════════════════════╝\n" RESET);
+    printf("Total tests: %d\n", test_count);
+    printf(GREEN "Passed: %d\n" RESET, test_passed);
+    printf("%s", test_failed > 0 ? RED : GREEN);
+    printf("Failed: %d\n" RESET, test_failed);
+
+    if (test_failed == 0) {
+        printf(GREEN "\n✓ All tests passed!\n\n" RESET);
+        exit(EXIT_SUCCESS);
+    } else {
+        printf(RED "\n✗ Some tests failed.\n\n" RESET);
+        exit(EXIT_FAILURE);
+    }
+}
+
+int main() {
+    run_all_tests();
+    return 0;
+}
@@ -74,9 +74,9 @@ struct BlockInfo {
 int count_blocks(memblock_t *start, memblock_t *end) {
     int count = 0;
     memblock_t *block = start;
-    while (block && block != end->next) {
+    while (block && block != TH_next(end)) {
         count++;
-        block = block->next;
+        block = TH_next(block);
     }
     return count;
 }
@@ -87,12 +87,12 @@ bool validate_block_chain() {
     
     while (block) {
         // Check backward link consistency
-        if (block->prev != prev) {
+        if (TH_prev(block) != prev) {
             printf(RED "✗ Block chain broken: backward link inconsistency\n" RESET);
             return false;
         }
         prev = block;
-        block = block->next;
+        block = TH_next(block);
     }
     return true;
 }
@@ -103,12 +103,12 @@ bool validate_block_sizes() {
     while (block) {
         // Sentinels should have specific sizes
         if (block == LASTBLOCK) {
-            if (block->size != 0) {
-                printf(RED "✗ LASTBLOCK size should be 0, got %u\n" RESET, block->size);
+            if (TH_size(block) != 0) {
+                printf(RED "✗ LASTBLOCK size should be 0, got %u\n" RESET, TH_size(block));
                 return false;
             }
         }
-        block = block->next;
+        block = TH_next(block);
     }
     return true;
 }
@@ -120,23 +120,23 @@ void print_heap_state() {
     
     while (block) {
         const char *tag_name;
-        if (block->tag == TH_FREE_TAG) {
+        if (TH_tag(block) == TH_FREE_TAG) {
             tag_name = "FREE";
-        } else if (block->tag & 0x80000000) {
+        } else if (TH_tag(block) & 0x80000000) {
             tag_name = "TAIL";
         } else {
             tag_name = "HEAD";
         }
         
         printf("Block %d: tag=0x%08x (%s), size=%u bytes, addr=%p\n",
-               block_num, block->tag, tag_name, block->size, (void *)block);
+               block_num, TH_tag(block), tag_name, TH_size(block), (void *)block);
         
         if (block == LASTBLOCK) {
             printf("         (LASTBLOCK sentinel)\n");
         }
         
         block_num++;
-        block = block->next;
+        block = TH_next(block);
     }
     printf(BLUE "==================\n\n" RESET);
 }
@@ -190,13 +190,13 @@ void test_initialization() {
     
     TEST_ASSERT(FIRSTBLOCK != NULL, "FIRSTBLOCK exists");
     TEST_ASSERT(LASTBLOCK != NULL, "LASTBLOCK exists");
-    TEST_ASSERT_EQ(FIRSTBLOCK->tag, TH_FREE_TAG, "FIRSTBLOCK is marked free");
-    TEST_ASSERT_EQ(LASTBLOCK->tag, TH_FREE_TAG, "LASTBLOCK is marked free");
-    TEST_ASSERT_EQ(LASTBLOCK->size, 0, "LASTBLOCK has size 0");
-    TEST_ASSERT(FIRSTBLOCK->next == LASTBLOCK, "FIRSTBLOCK->next points to LASTBLOCK");
-    TEST_ASSERT(LASTBLOCK->prev == FIRSTBLOCK, "LASTBLOCK->prev points to FIRSTBLOCK");
-    TEST_ASSERT(FIRSTBLOCK->prev == NULL, "FIRSTBLOCK->prev is NULL");
-    TEST_ASSERT(LASTBLOCK->next == NULL, "LASTBLOCK->next is NULL");
+    TEST_ASSERT_EQ(TH_tag(FIRSTBLOCK), TH_FREE_TAG, "FIRSTBLOCK is marked free");
+    TEST_ASSERT_EQ(TH_tag(LASTBLOCK), TH_FREE_TAG, "LASTBLOCK is marked free");
+    TEST_ASSERT_EQ(TH_size(LASTBLOCK), 0, "LASTBLOCK has size 0");
+    TEST_ASSERT(TH_next(FIRSTBLOCK) == LASTBLOCK, "FIRSTBLOCK->next points to LASTBLOCK");
+    TEST_ASSERT(TH_prev(LASTBLOCK) == FIRSTBLOCK, "LASTBLOCK->prev points to FIRSTBLOCK");
+    TEST_ASSERT(TH_prev(FIRSTBLOCK) == NULL, "FIRSTBLOCK->prev is NULL");
+    TEST_ASSERT(TH_next(LASTBLOCK) == NULL, "LASTBLOCK->next is NULL");
     TEST_ASSERT(validate_block_chain(), "Block chain is valid");
 }
 
@@ -390,6 +390,55 @@ void test_freetags_range() {
     print_heap_state();
 }
 
+static int cleared_count = 0;
+void count_cleared(uint8_t *ptr) {
+    (void)ptr;
+    cleared_count++;
+}
+
+void test_freetags_tail_lists() {
+    printf(YELLOW "\n--- Test: TH_freetags on Tail Tags ---\n" RESET);
+    TH_init();
+    
+    // Interleave tags so that each tag's blocks are spread out
+    uint8_t *ptrs[12];
+    for (int i = 0; i < 12; i++) {
+        ptrs[i] = TH_alloc(24 + 8*i, 0x80000004 + (i % 3));
+        memset(ptrs[i], 0x40 + i, 24 + 8*i);
+    }
+    // A tag above the per tag lists, and one that grows in place afterwards
+    uint8_t *high = TH_alloc(40, 0x80000020);
+    uint8_t *grown = TH_realloc(ptrs[11], 200);
+    TEST_ASSERT(grown != NULL, "Tail realloc succeeds");
+    ptrs[11] = grown;
+    
+    cleared_count = 0;
+    TH_freetags_cb(0x80000005, 0x80000006, count_cleared);
+    TEST_ASSERT_EQ(cleared_count, 8, "Callback sees exactly the blocks in the range");
+    TEST_ASSERT(validate_block_chain(), "Block chain valid after tail freetags");
+    
+    bool intact = true;
+    for (int i = 0; i < 12; i += 3) {
+        for (int j = 0; j < 24 + 8*i; j++) {
+            if (ptrs[i][j] != (uint8_t)(0x40 + i)) intact = false;
+        }
+    }
+    TEST_ASSERT(intact, "Blocks outside the range are untouched");
+    
+    cleared_count = 0;
+    TH_freetags_cb(0x80000004, 0x80000020, count_cleared);
+    TEST_ASSERT_EQ(cleared_count, 5, "Second range frees the rest including the shared list");
+    (void)high;
+    
+    // Freed blocks must have been merged with their free neighbours
+    bool merged = true;
+    memblock_t *block = (memblock_t *)&th_heap[TH_CACHEHEAPSIZE];
+    for (; TH_next(block); block = TH_next(block)) {
+        if (TH_tag(block) == TH_FREE_TAG && TH_tag(TH_next(block)) == TH_FREE_TAG && TH_size(TH_next(block)) > 0) merged = false;
+    }
+    TEST_ASSERT(merged, "No two free blocks are left next to each other");
+}
+
 void test_defragmentation() {
     printf(YELLOW "\n--- Test: Defragmentation ---\n" RESET);
     TH_init();
@@ -542,12 +591,8 @@ void test_complex_fragmentation_and_defrag() {
     
     print_heap_state();
     
-    // Clean up
-    for (int i = 0; i < 20; i++) {
-        if (ptrs[i]) {
-            TH_free((ptrs[i]));
-        }
-    }
+    // Clean up - by tag, as defrag has moved the blocks away from ptrs
+    TH_freetags(0x1000, 0x1000 + 19);
 }
 
 void test_defrag_with_pinned_blocks() {
@@ -573,6 +618,47 @@ void test_defrag_with_pinned_blocks() {
     print_heap_state();
 }
 
+void test_incremental_defrag() {
+    printf(YELLOW "\n--- Test: Incremental Defragmentation ---\n" RESET);
+    TH_init();
+    
+    uint8_t *ptrs[20];
+    for (int i = 0; i < 20; i++) {
+        ptrs[i] = TH_alloc(128, 0x1000 + i);
+    }
+    for (int i = 0; i < 20; i += 3) {
+        TH_free(ptrs[i]);
+        ptrs[i] = NULL;
+    }
+    
+    // Two blocks per step - the pass must be spread over several calls
+    DefragState::moves_count = 0;
+    int steps = 1;
+    bool done = TH_defrag_step(defrag_count_all_moves, 256);
+    TEST_ASSERT(!done, "First step stops at the byte budget");
+    TEST_ASSERT(DefragState::moves_count == 2, "First step moves two blocks");
+    TEST_ASSERT(validate_block_chain(), "Block chain valid between steps");
+    
+    // Free a block below the cursor between steps - the next step must start over
+    TH_free(ptrs[1]);
+    ptrs[1] = NULL;
+    TEST_ASSERT(validate_block_chain(), "Block chain valid after free between steps");
+    
+    while (!done && steps < 100) {
+        done = TH_defrag_step(defrag_count_all_moves, 256);
+        steps++;
+    }
+    printf(BLUE "Pass finished in %d steps (moved %d blocks)\n" RESET, steps, DefragState::moves_count);
+    TEST_ASSERT(done, "Incremental defrag completes");
+    TEST_ASSERT(validate_block_chain(), "Block chain valid after incremental defrag");
+    
+    // All free space should now be contiguous: 8 freed blocks plus their headers
+    uint8_t *big = TH_alloc(8 * 128, 0x2000);
+    TEST_ASSERT(big != NULL, "Freed space is contiguous after incremental defrag");
+    
+    print_heap_state();
+}
+
 void test_allocation_alignment() {
     printf(YELLOW "\n--- Test: Allocation 4-uint8_t Alignment ---\n" RESET);
     TH_init();
@@ -964,11 +1050,13 @@ void run_all_tests() {
     test_freeblock_case_3_merge_both();
     test_cascade_merges();
     test_freetags_range();
+    test_freetags_tail_lists();
     test_countfreehead();
     test_alloc_at_capacity();
     test_defragmentation();
     test_defrag_with_pinned_blocks();
     test_complex_fragmentation_and_defrag();
+    test_incremental_defrag();
     test_rapid_alloc_free_cycles();
     test_allocation_alignment();
     test_realloc_null_ptr();
@@ -1,12 +1,27 @@
 #ifndef __W_LUMPS_H__
 #define __W_LUMPS_H__
 #include <stdint.h>
+
+/**
+ * Set NC_PACKED_WAD to 1 to read gbadoom1z.wad, where most lumps are LZ4 packed. It is made
+ * by wad2cc.py --pack along with the gbadoom1z_lumps tables, which must be linked instead.
+ */
+#ifndef NC_PACKED_WAD
+#define NC_PACKED_WAD 0
+#endif
+
+#if NC_PACKED_WAD == 1
+#include "gbadoom1z_lumps.h"
+#else
 #include "gbadoom1_lumps.h"
+#define WADPACK_MARGIN 0
+#endif
 #include "../newcache/newcache.h"
 
 int LC_CheckNumForName(const char *name);
 const char* LC_GetNameForNum(int lump, char buffer[8]);
 int LC_LumpLength(int lumpnum);
+int LC_PackedSize(int lumpnum);
 filelump_t LC_LumpForNum(int lumpnum);
 void LC_Init(void);
  
@@ -11,6 +11,190 @@
 #include <assert.h>
 #endif
 
+/**
+ * Set NC_PREFETCH_THREADED to 1 to service NC_Prefetch() requests from a background loader 
+ * thread (host ports). When 0, queued requests are serviced by NC_ServicePrefetch() or on 
+ * first access, which keeps single threaded targets working unchanged.
+ */
+#ifndef NC_PREFETCH_THREADED
+#define NC_PREFETCH_THREADED 0
+#endif
+
+// Number of outstanding prefetch requests - must be a power of two
+#ifndef NC_PREFETCH_QUEUE
+#define NC_PREFETCH_QUEUE 32
+#endif
+
+/**
+ * Level warm-up: the lumps that miss during the first NC_TRACE_TICS tics of a map are recorded
+ * in a manifest. The next time the map is loaded, up to NC_PRELOAD_BYTES of them are loaded
+ * up front in WAD order. Manifests live in RAM for NC_TRACE_MAPS maps.
+ */
+#ifndef NC_TRACE_TICS
+#define NC_TRACE_TICS 70
+#endif
+
+#ifndef NC_TRACE_MAPS
+#define NC_TRACE_MAPS 4
+#endif
+
+#ifndef NC_TRACE_LUMPS
+#define NC_TRACE_LUMPS 128
+#endif
+
+#ifndef NC_PRELOAD_BYTES
+#define NC_PRELOAD_BYTES (TH_CACHEHEAPSIZE/2)
+#endif
+
+/**
+ * Epochs: the number of entries that can be held pinned from their first access in an 
+ * epoch until NC_EndEpoch(). Accesses beyond that go through the normal pin/unpin path.
+ */
+#ifndef NC_EPOCH_PINS
+#define NC_EPOCH_PINS 64
+#endif
+
+// Upper bound on the bytes an epoch holds, so that there is room left to load what it misses
+#ifndef NC_EPOCH_BYTES
+#define NC_EPOCH_BYTES (TH_CACHEHEAPSIZE/2)
+#endif
+
+// Epochs only hold lumps after this many epochs in a row without evictions. A held lump can't
+// move, so holding while the cache is churning leaves too little room for what it loads next.
+#ifndef NC_EPOCH_CALM
+#define NC_EPOCH_CALM 32
+#endif
+
+/**
+ * Page-granular loading: a lump of at least NC_PAGED_MIN bytes that is first reached through
+ * NC_PinRange() gets room for all of it, but only the pages covering the range are read. Other
+ * pages are read when a later range needs them, and all of them on a whole-lump access. A lump
+ * has at most 32 pages, so pages are a multiple of NC_PAGE_SIZE bytes.
+ */
+#ifndef NC_PAGE_SIZE
+#define NC_PAGE_SIZE 512
+#endif
+
+#ifndef NC_PAGED_MIN
+#define NC_PAGED_MIN 8192
+#endif
+
+/**
+ * Idle defragmentation: NC_IdleDefrag() compacts the cache a little at a time, moving at most
+ * NC_IDLE_DEFRAG_BYTES per call, so that allocations on a miss rarely need a full defrag
+ */
+#ifndef NC_IDLE_DEFRAG_BYTES
+#define NC_IDLE_DEFRAG_BYTES 4096
+#endif
+
+/**
+ * Level transitions: NC_EndLevel() evicts the lumps of the map that is left and entries that
+ * haven't been used in the last NC_WARM_TICS tics of play. The rest (palette, status bar, weapon
+ * sprites, common textures and so on) stays warm for the next map. Recency is counted in game
+ * tics rather than frames, as the intermission and menus draw frames but don't run tics.
+ */
+#ifndef NC_WARM_TICS
+#define NC_WARM_TICS 35
+#endif
+
+/**
+ * Telemetry: the number of finished frames kept for the ports to read, and whether to
+ * count misses per lump (2 bytes per lump, so off by default on the GBA)
+ */
+#ifndef NC_STATS_FRAMES
+#define NC_STATS_FRAMES 16
+#endif
+
+#ifndef NC_STATS_LUMPMISSES
+#ifdef GBA
+#define NC_STATS_LUMPMISSES 0
+#else
+#define NC_STATS_LUMPMISSES 1
+#endif
+#endif
+
+/**
+ * Set NC_ACCESSTRACE to 1 to log every call into the cache API to NC_ACCESSTRACE_FILE, 
+ * for replay in the offline simulator in sim/
+ */
+#ifndef NC_ACCESSTRACE
+#define NC_ACCESSTRACE 0
+#endif
+
+#ifndef NC_ACCESSTRACE_FILE
+#define NC_ACCESSTRACE_FILE "ncaccess.trace"
+#endif
+
+#if NC_ACCESSTRACE == 1
+#include <stdio.h>
+#endif
+
+/**
+ * Eviction policy, selected at build time:
+ * NC_POLICY_LRU   - evict the least recently pinned entry. Every pin relinks the entry.
+ * NC_POLICY_CLOCK - second chance: a pin only sets a reference bit, and a clock hand
+ *                   sweeping the entries clears it or evicts.
+ * NC_POLICY_2Q    - new entries are on probation until they are used again in a later
+ *                   frame. Probationary entries are evicted first, so lumps only touched
+ *                   during one BSP walk don't push out the working set.
+ * NC_POLICY_GDS   - GreedyDual-Size: evict the entry with the lowest reload cost per
+ *                   byte, aged so that entries that aren't used lose their credit.
+ */
+#define NC_POLICY_LRU 0
+#define NC_POLICY_CLOCK 1
+#define NC_POLICY_2Q 2
+#define NC_POLICY_GDS 3
+
+#ifndef NC_EVICTION_POLICY
+#define NC_EVICTION_POLICY NC_POLICY_LRU
+#endif
+
+// 2Q: share of the cache heap probationary entries may take before they are preferred victims 
+#ifndef NC_2Q_PROBATION_BYTES
+#define NC_2Q_PROBATION_BYTES (TH_CACHEHEAPSIZE/4)
+#endif
+
+// 2Q: number of lumps recently evicted from probation to remember, so they go straight to
+// the protected set if they come back
+#ifndef NC_2Q_GHOSTS
+#define NC_2Q_GHOSTS 32
+#endif
+
+// GreedyDual-Size: reload cost of a lump in bytes on top of its size (setup of a flash read)
+#ifndef NC_GDS_READ_OVERHEAD
+#define NC_GDS_READ_OVERHEAD 512
+#endif
+
+// Width of a cache index. With 8 bits at most 251 lumps can be cached at once no matter how
+// big the heap is. 16 bits gives every lump its own entry, so large caches aren't limited by
+// lump count - at the cost of doubling the per-lump map and the per-entry state.
+#ifndef NC_INDEX_BITS
+#define NC_INDEX_BITS 8
+#endif
+
+#if NC_INDEX_BITS == 8
+typedef uint8_t nc_entry_t;
+#define NC_ENTRIES 256
+#elif NC_INDEX_BITS == 16
+typedef uint16_t nc_entry_t;
+#define NC_ENTRIES (MAXLUMPS+5) // One per lump, the three static objects and the list ends
+#else
+#error "NC_INDEX_BITS must be 8 or 16"
+#endif
+
+// The top indices are reserved: the end of the LRU list and the permanently mapped objects
+#define NC_ENTRY_END (NC_ENTRIES-1)
+#define NC_ENTRY_NULL (NC_ENTRIES-2)
+#define NC_ENTRY_STBAR (NC_ENTRIES-3)
+#define NC_ENTRY_JUNK (NC_ENTRIES-4)
+
+#if NC_PREFETCH_THREADED == 1
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
 
 extern unsigned char gfx_stbar[];
 extern line_t junk;
@@ -18,7 +202,7 @@ extern line_t junk;
 #define ASSERT_PTR_IN_HEAP(ptr) assert((uint8_t *)(ptr) >= &th_heap[0] && (uint8_t *)(ptr) < &th_heap[TH_HEAPSIZE])
 #define ASSERT_VALID_LUMPNUM(lumpnum) assert(lumpnum >= 0 && lumpnum < MAXLUMPS)
 #define ASSERT_VALID_LUMPNUM_OR_MINUS1(lumpnum) assert((lumpnum >= -1 && lumpnum < MAXLUMPS))
-#define ASSERT_VALID_CACHE_ENTRY(entry) assert(entry >= 1 && entry <= 254)
+#define ASSERT_VALID_CACHE_ENTRY(entry) assert(entry >= 1 && entry <= NC_ENTRY_NULL)
 
 
 /**
@@ -28,41 +212,180 @@ extern line_t junk;
 
  /**
  * The LUT for indexing into the actual cache. 0 means that nothing is cached for this
- * 1-254 are valid cache indices. The last three has special meaning:
- * 252 : junk line_t
- * 253 : gfx_stbar
- * 254 : nullptr (used for the -1 index)
+ * 1-NC_ENTRY_NULL are valid cache indices. The last three has special meaning:
+ * NC_ENTRY_JUNK : junk line_t
+ * NC_ENTRY_STBAR : gfx_stbar
+ * NC_ENTRY_NULL : nullptr (used for the -1 index)
  */
-static uint8_t _cache[MAXLUMPS+1];
-static uint8_t *cache = _cache+1; // Allow -1 index
+static nc_entry_t _cache[MAXLUMPS+1];
+static nc_entry_t *cache = _cache+1; // Allow -1 index
 
 
 
 /**
  * The pointers that map cache indices to objects, either allocated on the heap using TH_alloc or by static mapping set up in InitCache()
  */
-static uint8_t *pointers[256];
+static uint8_t *pointers[NC_ENTRIES];
 
 /**
  * The number of times an object has been pinned. Pinned objects can't be moved during a defrag, and they can't be evicted. Static mappings
  * are always pinned so that we never try to move or evict them. Pinning happens when a proxy object is converted to a pointer, either by
  * means of operator T*() on a Pnned<T> (produced by .pin()) or by means of a Sentinel implementing operator->()
  */
-static uint8_t pincount[256];
+static uint8_t pincount[NC_ENTRIES];
 
 /**
- * A doubly linked list implemented as an array. Start is index 0 and end is index 255, which is why cache indices can only be 1-254.
+ * A doubly linked list implemented as an array. Start is index 0 and end is index NC_ENTRY_END, which is why cache indices can only be
+ * 1-NC_ENTRY_NULL.
  * It serves two purposes:
  * 1) Track free entries by means of the .free singly linked list
  * 2) Track least recently used entries, by pushing an entry to the front each time it is pinned. 
  */
 static struct {
-    uint8_t next;
+    nc_entry_t next;
     union {
-        uint8_t prev;
-        uint8_t free;
+        nc_entry_t prev;
+        nc_entry_t free;
+    };
+} lru[NC_ENTRIES];
+
+/**
+ * The pages of each entry that are loaded. All bits are set when the whole lump is loaded, 
+ * which is the case for everything not brought in by NC_PinRange().
+ */
+static uint32_t pagemask[NC_ENTRIES];
+
+/**
+ * Prefetch state of each cache entry. An entry that has a prefetch request in flight holds
+ * a pin so that it is neither evicted nor moved while the loader writes into it.
+ */
+#define PF_IDLE 0    // No prefetch outstanding
+#define PF_QUEUED 1  // Allocated and queued, data not loaded yet
+#define PF_LOADED 2  // Data loaded, the pin taken by NC_Prefetch not released yet
+
+/**
+ * Single producer (game thread), single consumer (loader) ring of prefetch requests. 
+ * Slots between reap and head are done, slots between head and tail are waiting for
+ * the loader.
+ */
+typedef struct {
+    uint8_t *block;
+    uint8_t *dst;
+    int offset;
+    int len;
+    short lumpnum;
+    nc_entry_t entry;   // 0 once the request is cancelled
+} prefetch_t;
+
+static prefetch_t pfqueue[NC_PREFETCH_QUEUE];
+
+#if NC_PREFETCH_THREADED == 1
+static std::atomic<uint8_t> pfstate[NC_ENTRIES];
+static std::atomic<unsigned> pfhead;
+static std::atomic<unsigned> pftail;
+static std::mutex wrlock;           // The flash device is shared between loader and game thread
+static std::mutex pfwakelock;       // Only used to put the loader to sleep - queue is lock free
+static std::condition_variable &pfwake = *new std::condition_variable; // Never destroyed as the loader may sleep on it at exit
+#else
+static uint8_t pfstate[NC_ENTRIES];
+static unsigned pfhead;
+static unsigned pftail;
+#endif
+static unsigned pfreap;
+static int pfinflight = 0; // Number of entries not in PF_IDLE - keeps the hit path cheap
+
+/**
+ * Epoch state. Entries accessed through NC_EpochPtr() during an epoch are pinned once and
+ * listed in epochpins, and nc_epochptrs[lumpnum+1] is set so that the proxies find the pointer
+ * inline. The static mappings are always pinned and so are always held. The pins are only
+ * dropped by NC_EndEpoch(), so entries are only held after NC_EPOCH_CALM epochs without any
+ * eviction, and when that leaves a run of at least epochreserve bytes that can be evicted or
+ * moved. Entries refused get epochtried[entry] set to epochgen, so they aren't tried again in
+ * the same epoch.
+ *
+ * The runs of at least epochreserve bytes are found once per epoch, on the first lump it tries
+ * to hold, and split as lumps are held. Runs beyond NC_EPOCH_RUNS are left out, which only
+ * makes the epoch hold less.
+ */
+#define NC_EPOCH_RUNS 4
+
+const uint8_t *nc_epochptrs[MAXLUMPS+1];
+static bool nc_epochactive = false;
+static int epochdepth = 0;
+static nc_entry_t epochpins[NC_EPOCH_PINS];
+static int epochcount = 0;
+static int epochbytes = 0;
+static int epochreserve = 0;
+static uint8_t epochtried[NC_ENTRIES];
+static uint8_t epochgen = 0;
+static uint32_t epochevictions = 0;
+static int epochcalm = 0;
+static const uint8_t *epochruns[NC_EPOCH_RUNS][2]; // Start and end of each run
+static int epochnruns = -1;                        // -1 until found in this epoch
+
+/**
+ * Per map manifest of the lumps that were missed in the first tics, in the order they were first 
+ * needed. Slots are reused round robin when more maps than NC_TRACE_MAPS are played.
+ */
+typedef struct {
+    short maplump;  // -1 for an unused slot
+    short count;
+    short lumps[NC_TRACE_LUMPS];
+} manifest_t;
+
+static manifest_t manifests[NC_TRACE_MAPS];
+static int nextmanifest = 0;
+static manifest_t *tracing = nullptr;    // Manifest being recorded, if any
+static int tracetics = 0;
+static uint8_t traced[(MAXLUMPS+7)/8];  // Lumps already in the manifest being recorded
+
+/**
+ * Telemetry counters, and the state at the start of the current frame so that
+ * NC_EndFrame() can store the difference in the ring
+ */
+static nc_stats_t stats;
+static nc_stats_t framestart;
+static nc_stats_t framestats[NC_STATS_FRAMES];
+#if NC_STATS_LUMPMISSES == 1
+static uint16_t lumpmisses[MAXLUMPS];
+#endif
+
+/**
+ * The game tic each entry was last used in (low 16 bits), and the map lump of the current level
+ */
+static uint16_t lastused[NC_ENTRIES];
+static uint16_t gametic;
+static int levelmap = -1;
+
+static inline void MarkUsed(nc_entry_t entry) {
+    lastused[entry] = gametic;
+}
+
+#if NC_ACCESSTRACE == 1
+static FILE *accesstrace = nullptr;
+
+static void TraceAccess(char op, int arg) {
+    if (!accesstrace) return;
+    nc_tracerecord_t rec = {(uint8_t)op, 0, (int16_t)arg};
+    fwrite(&rec,sizeof(rec),1,accesstrace);
+}
+#define TRACE_ACCESS(op,arg) TraceAccess(op,arg)
+
+// A range takes a second record with the range in 16 byte units - enough to get the pages right
+static void TraceRange(int lumpnum, int offset, int len) {
+    if (!accesstrace) return;
+    int units = (len+(offset&15)+15)>>4;
+    nc_tracerecord_t recs[2] = {
+        {NC_TRACE_PINRANGE, 0, (int16_t)lumpnum},
+        {NC_TRACE_RANGE, (uint8_t)(units > 255 ? 255 : units), (int16_t)(offset>>4)}
     };
-} lru[256];
+    fwrite(recs,sizeof(recs[0]),2,accesstrace);
+}
+#define TRACE_RANGE(lumpnum,offset,len) TraceRange(lumpnum,offset,len)
+#else
+#define TRACE_ACCESS(op,arg)
+#define TRACE_RANGE(lumpnum,offset,len)
+#endif
 
 /** 
  * The header for the WAD file. This is set up by WR_Init()
@@ -74,41 +397,67 @@ static wadinfo_t header;
  */
 static int allocated = 0;
 
+/**
+ * Set when an eviction has left a hole in the cache, cleared when a defrag pass has finished
+ */
+static bool fragmented = false;
+
 /**
  * Cache initialization function. It:
  * - Sets all entries to 0 (unmapped)
  * - Prefills the special entries (-1 mapping to nullptr, STBAR_LUMP_NUM mapping to gfx_stbar and JUNK_LUMP_NUM mapping to junk)
  *   These objects are always pinned by setting pincount to 1 and thereby never have it 0 (pin and unpin is always symmetric)
- * - Initialize the free list to map to 1-251
+ * - Initialize the free list to map to 1-(NC_ENTRY_JUNK-1)
  */
 static void InitCache() {
     // Set all entries to 0 (unmapped)
     for (int i=-1;i<MAXLUMPS;i++)
         cache[i]=0;
     // Prefill special entries
-    cache[-1]=254;
-    pointers[254]=nullptr;
-    pincount[254]=1; // Never deallocate
-    cache[STBAR_LUMP_NUM]=253;
-    pointers[253]=gfx_stbar;
-    pincount[253]=1;
-    cache[JUNK_LUMP_NUM]=252;
-    pointers[252]=(uint8_t *)&junk;
-    pincount[252]=1;
+    cache[-1]=NC_ENTRY_NULL;
+    pointers[NC_ENTRY_NULL]=nullptr;
+    pincount[NC_ENTRY_NULL]=1; // Never deallocate
+    cache[STBAR_LUMP_NUM]=NC_ENTRY_STBAR;
+    pointers[NC_ENTRY_STBAR]=gfx_stbar;
+    pincount[NC_ENTRY_STBAR]=1;
+    cache[JUNK_LUMP_NUM]=NC_ENTRY_JUNK;
+    pointers[NC_ENTRY_JUNK]=(uint8_t *)&junk;
+    pincount[NC_ENTRY_JUNK]=1;
     // Set up the LRU - for pinning to work without special cases, the three constant ones must be part of it
-    lru[0].next=252;
-    lru[252].next=253;
-    lru[253].next=254;
-    lru[254].next=255;    
-    lru[255].prev=254;
-    lru[254].prev=253;
-    lru[253].prev=252;
-    lru[252].prev=0;
-    for (int i=1; i<252; i++) {
+    lru[0].next=NC_ENTRY_JUNK;
+    lru[NC_ENTRY_JUNK].next=NC_ENTRY_STBAR;
+    lru[NC_ENTRY_STBAR].next=NC_ENTRY_NULL;
+    lru[NC_ENTRY_NULL].next=NC_ENTRY_END;    
+    lru[NC_ENTRY_END].prev=NC_ENTRY_NULL;
+    lru[NC_ENTRY_NULL].prev=NC_ENTRY_STBAR;
+    lru[NC_ENTRY_STBAR].prev=NC_ENTRY_JUNK;
+    lru[NC_ENTRY_JUNK].prev=0;
+    for (int i=1; i<NC_ENTRY_JUNK; i++) {
         lru[i-1].free=i;
     }
-    lru[251].free=0;
+    lru[NC_ENTRY_JUNK-1].free=0;
     allocated = 0;
+    for (int i=0; i<NC_ENTRIES; i++) 
+        pfstate[i] = PF_IDLE;
+    memset(pagemask,0xff,sizeof(pagemask));
+    pfhead = pftail = pfreap = 0;
+    pfinflight = 0;
+    memset(nc_epochptrs,0,sizeof(nc_epochptrs));
+    memset(epochtried,0,sizeof(epochtried));
+    nc_epochptrs[STBAR_LUMP_NUM+1] = pointers[NC_ENTRY_STBAR];
+    nc_epochptrs[JUNK_LUMP_NUM+1] = pointers[NC_ENTRY_JUNK];
+    epochcount = epochdepth = epochbytes = epochgen = epochcalm = 0;
+    epochevictions = 0;
+    epochnruns = -1;
+    nc_epochactive = false;
+    for (int i=0; i<NC_TRACE_MAPS; i++)
+        manifests[i].maplump = -1;
+    tracing = nullptr;
+    memset(&stats,0,sizeof(stats));
+    memset(&framestart,0,sizeof(framestart));
+    #if NC_STATS_LUMPMISSES == 1
+    memset(lumpmisses,0,sizeof(lumpmisses));
+    #endif
 }
 
 /**
@@ -118,7 +467,7 @@ static uint32_t lumpnum_for_ptr(const uint8_t *ptr) {
     ASSERT_PTR_IN_HEAP(ptr);
     auto block = (const th_memblock_t *)ptr;
     block -= 1;
-    auto lumpnum = block->tag;
+    auto lumpnum = TH_tag(block);
     ASSERT_VALID_LUMPNUM(lumpnum);
     return lumpnum;
 }
@@ -130,8 +479,8 @@ static uint32_t size_for_ptr(const uint8_t *ptr){
     ASSERT_PTR_IN_HEAP(ptr);
     auto block = (const th_memblock_t *)ptr;
     block -= 1;
-    ASSERT_VALID_LUMPNUM(block->tag); // At least check that the tag is a valid lumpnum
-    return block->size;
+    ASSERT_VALID_LUMPNUM(TH_tag(block)); // At least check that the tag is a valid lumpnum
+    return TH_size(block);
 
 }
 
@@ -140,10 +489,10 @@ static uint32_t size_for_ptr(const uint8_t *ptr){
  */
 static void PrintHeapStatus() {
     #if TH_CANARY_ENABLED == 1
-    uint8_t entry = 0;
+    nc_entry_t entry = 0;
     printf("\nHeap:\n");
-    while (entry != 255) {
-        uint8_t next_entry = lru[entry].next;
+    while (entry != NC_ENTRY_END) {
+        nc_entry_t next_entry = lru[entry].next;
         const char* status = (lru[next_entry].prev==entry) ? "OK" : "Broken";
         const char* pinned = (pincount[next_entry]) ? "Pinned" : "Unpin";
         printf("%d %s %s(%d)\n",next_entry,pinned,status,lru[next_entry].prev);
@@ -162,7 +511,7 @@ static void PrintHeapStatus() {
  * Helper function that removes entry from the LRU by linking the preceding and proceeding 
  * entries together
  */
-static void RemoveEntryFromLRU(uint8_t entry) {
+static void RemoveEntryFromLRU(nc_entry_t entry) {
     ASSERT_VALID_CACHE_ENTRY(entry);
     auto prev = lru[entry].prev;
     auto next = lru[entry].next;
@@ -174,7 +523,7 @@ static void RemoveEntryFromLRU(uint8_t entry) {
 /**
  * Helper function that inserts the entry at the front of the LRU
  */
-static void InsertInFrontOfLRU(uint8_t entry) {
+static void InsertInFrontOfLRU(nc_entry_t entry) {
     ASSERT_VALID_CACHE_ENTRY(entry);
     // 0 -> entry -> end
     // 0 <-       <- end
@@ -184,21 +533,204 @@ static void InsertInFrontOfLRU(uint8_t entry) {
     lru[0].next = entry;
 }
 
-/** Evict the least used non-pinned block. Return 0 if nothing can be evicted,
+/**
+ * Eviction policy. All policies keep the resident entries in the LRU list, which is in insertion
+ * order unless the policy relinks on touch. They implement:
+ * PolicyInit()             - the cache has been reset
+ * PolicyInsert(entry,bytes) - entry was just allocated and inserted in front of the list
+ * PolicyTouch(entry)        - entry is pinned
+ * PolicyRemove(entry)       - entry is about to be evicted
+ * PolicyVictim()            - pick an unpinned entry to evict, or 0 if everything is pinned
+ */
+#if NC_EVICTION_POLICY == NC_POLICY_LRU
+
+static inline void PolicyInit() {
+}
+
+static inline void PolicyInsert(nc_entry_t, int) {
+}
+
+static inline void PolicyTouch(nc_entry_t entry) {
+    // Move entry up front in the LRU
+    RemoveEntryFromLRU(entry);
+    InsertInFrontOfLRU(entry);
+}
+
+static inline void PolicyRemove(nc_entry_t) {
+}
+
+static nc_entry_t PolicyVictim() {
+    // The least recently used entry that isn't pinned
+    nc_entry_t entry = lru[NC_ENTRY_END].prev;
+    while (entry && pincount[entry]) {
+        entry = lru[entry].prev;
+    }
+    return entry;
+}
+
+#elif NC_EVICTION_POLICY == NC_POLICY_CLOCK
+
+static uint8_t referenced[NC_ENTRIES];
+static nc_entry_t hand = 0;    // Next entry the clock looks at, 0 to restart from the oldest
+
+static inline void PolicyInit() {
+    hand = 0;
+}
+
+static inline void PolicyInsert(nc_entry_t entry, int) {
+    referenced[entry] = 0;
+}
+
+static inline void PolicyTouch(nc_entry_t entry) {
+    referenced[entry] = 1;
+}
+
+static inline void PolicyRemove(nc_entry_t entry) {
+    if (hand == entry) hand = lru[entry].prev;
+}
+
+static nc_entry_t PolicyVictim() {
+    // Sweep from the oldest entry towards the newest. Two full turns are enough to clear all
+    // reference bits, so if nothing is found by then everything is pinned.
+    for (int steps = 0; steps < 2*NC_ENTRIES; steps++) {
+        if (!hand) hand = lru[NC_ENTRY_END].prev;
+        if (!hand) return 0;
+        nc_entry_t entry = hand;
+        hand = lru[entry].prev;
+        if (pincount[entry]) continue;
+        if (!referenced[entry]) return entry;
+        referenced[entry] = 0;
+    }
+    return 0;
+}
+
+#elif NC_EVICTION_POLICY == NC_POLICY_2Q
+
+static uint8_t probation[NC_ENTRIES];          // Entry hasn't been used again since it was loaded
+static uint32_t loadframe[NC_ENTRIES];         // Frame the entry was loaded in
+static int probationbytes = 0;
+static short ghosts[NC_2Q_GHOSTS];      // Lumps recently evicted from probation
+static unsigned nextghost = 0;
+
+static inline void PolicyInit() {
+    probationbytes = 0;
+    for (int i=0; i<NC_2Q_GHOSTS; i++)
+        ghosts[i] = -1;
+}
+
+static inline void PolicyInsert(nc_entry_t entry, int bytes) {
+    int lumpnum = lumpnum_for_ptr(pointers[entry]);
+    probation[entry] = 1;
+    for (int i=0; i<NC_2Q_GHOSTS; i++) {
+        if (ghosts[i] == lumpnum) {
+            // Evicted too early last time - protect it right away
+            probation[entry] = 0;
+            ghosts[i] = -1;
+        }
+    }
+    if (probation[entry]) probationbytes += bytes;
+    loadframe[entry] = stats.frame;
+}
+
+static inline void PolicyTouch(nc_entry_t entry) {
+    if (probation[entry] && loadframe[entry] != stats.frame) {
+        // Used again after the frame it was loaded in - move it to the protected set
+        probation[entry] = 0;
+        probationbytes -= size_for_ptr(pointers[entry]);
+    }
+    if (!probation[entry]) {
+        RemoveEntryFromLRU(entry);
+        InsertInFrontOfLRU(entry);
+    }
+}
+
+static inline void PolicyRemove(nc_entry_t entry) {
+    if (probation[entry]) {
+        probation[entry] = 0;
+        probationbytes -= size_for_ptr(pointers[entry]);
+        ghosts[nextghost++ % NC_2Q_GHOSTS] = lumpnum_for_ptr(pointers[entry]);
+    }
+}
+
+static nc_entry_t PolicyVictim() {
+    nc_entry_t fallback = 0;
+    // Oldest probationary entry if they take up too much, otherwise the least recently used
+    for (nc_entry_t entry = lru[NC_ENTRY_END].prev; entry; entry = lru[entry].prev) {
+        if (pincount[entry]) continue;
+        if (probation[entry] && probationbytes > NC_2Q_PROBATION_BYTES) return entry;
+        if (!fallback) fallback = entry;
+        if (probationbytes <= NC_2Q_PROBATION_BYTES) break;
+    }
+    return fallback;
+}
+
+#elif NC_EVICTION_POLICY == NC_POLICY_GDS
+
+static uint32_t credit[NC_ENTRIES];    // H in GreedyDual: inflation + reload cost per byte
+static uint32_t inflation = 0;  // L in GreedyDual: the credit of the last victim
+
+static inline void PolicyInit() {
+    inflation = 0;
+}
+
+static inline uint32_t CostPerByte(nc_entry_t entry) {
+    uint32_t size = size_for_ptr(pointers[entry]);
+    // Fixed point with 8 fractional bits, so that even large lumps have a nonzero cost
+    return ((NC_GDS_READ_OVERHEAD + size) << 8) / (size ? size : 1);
+}
+
+static inline void PolicyInsert(nc_entry_t entry, int) {
+    credit[entry] = inflation + CostPerByte(entry);
+}
+
+static inline void PolicyTouch(nc_entry_t entry) {
+    if (entry < NC_ENTRY_JUNK) credit[entry] = inflation + CostPerByte(entry);
+}
+
+static inline void PolicyRemove(nc_entry_t entry) {
+    inflation = credit[entry];
+    if (inflation & 0x80000000) {
+        // All credits are at least the inflation - rebase them before they wrap
+        for (nc_entry_t e = lru[NC_ENTRY_END].prev; e; e = lru[e].prev) 
+            credit[e] -= inflation;
+        inflation = 0;
+    }
+}
+
+static nc_entry_t PolicyVictim() {
+    nc_entry_t victim = 0;
+    for (nc_entry_t entry = lru[NC_ENTRY_END].prev; entry; entry = lru[entry].prev) {
+        if (pincount[entry]) continue;
+        if (!victim || credit[entry] < credit[victim]) victim = entry;
+    }
+    return victim;
+}
+
+#else
+#error "Unknown NC_EVICTION_POLICY"
+#endif
+
+static int EvictEntry(nc_entry_t entry);
+
+/** Evict a non-pinned block chosen by the eviction policy. Return 0 if nothing can be evicted,
  * otherwise the number of bytes made available will be returned.
  */
 static int EvictOne() {
     #if TH_CANARY_ENABLED == 1
     printf("INFO: Tryingn to evict one... ");
     #endif
-    uint8_t entry = lru[255].prev;
-    while (entry && pincount[entry]) {
-        entry = lru[entry].prev;
-    }
-    // If prev is 0, then we have nothing to evict - otherwise evict the least
-    // recently used
+    nc_entry_t entry = PolicyVictim();
+    // If there is no victim, everything is pinned
     if (!entry) return 0;
+    return EvictEntry(entry);
+}
+
+/**
+ * Evict a given entry, which must not be pinned. Returns the number of bytes made available.
+ */
+static int EvictEntry(nc_entry_t entry) {
     ASSERT_VALID_CACHE_ENTRY(entry);
+    PolicyRemove(entry);
     // Take it out of the LRU list and free it
     RemoveEntryFromLRU(entry);
     // Insert in free list
@@ -210,6 +742,8 @@ static int EvictOne() {
     allocated -= size_for_ptr(ptr);
     auto freed = TH_free(ptr);
     pointers[entry]=nullptr;
+    stats.evictions++;
+    fragmented = true;
     #if TH_CANARY_ENABLED == 1
     printf(" lump %d from cache freeing %d bytes at entry %d\n",lumpnum,freed,entry);
     if (TH_checkhealth_verbose()==false) {
@@ -236,11 +770,21 @@ static bool defrag_cb(short lumpnum, uint8_t *proposed_newptr){
     }
     ASSERT_VALID_CACHE_ENTRY(entry);
     if (pincount[entry]) return false; // Can't move pinned objects
+    stats.defragbytes += size_for_ptr(pointers[entry]);
     // Register the new pointer and give OK to move.
     pointers[entry]=proposed_newptr;
     return true;
 }
 
+/**
+ * Defragment the cache region, keeping count
+ */
+static void Defrag() {
+    stats.defrags++;
+    TH_defrag(defrag_cb);
+    fragmented = false;
+}
+
 bool NC_FreeSomeMemoryForTail(){
     #if TH_CANARY_ENABLED == 1
     printf("INFO: Trying to free some memory for tail\n");
@@ -248,16 +792,18 @@ bool NC_FreeSomeMemoryForTail(){
     while (EvictOne()) {
         // Keep evicting until we can't evict any more
     }
-    TH_defrag(defrag_cb);
+    Defrag();
     return true;
 }
 
+static void DrainPrefetch();
+
 /**
  * Allocate a new area in the cache and push it to the front of the LRU
  * Note that this fuction by design will exit the program if it can't allocate thus
  * always returning a valid pointer.
  */
-static uint8_t AllocateIntoCache(int bytes, int lumpnum) {
+static nc_entry_t AllocateIntoCache(int bytes, int lumpnum) {
     ASSERT_VALID_LUMPNUM(lumpnum);
     #if TH_CANARY_ENABLED == 1
     printf("\nINFO: Trying to allocate %d bytes for lump %d\n",bytes,lumpnum);
@@ -271,6 +817,11 @@ static uint8_t AllocateIntoCache(int bytes, int lumpnum) {
         while (freemem < bytes){
             auto freed = EvictOne();
             freemem += freed;
+            if (!freed && pfinflight) {
+                // Prefetched entries are pinned until loaded - finish them so they can go
+                DrainPrefetch();
+                continue;
+            }
             if (!freed) {
                 #if TH_CANARY_ENABLED == 1
                 printf("FATAL: Couldn't evict any useful amount..\n");
@@ -286,7 +837,7 @@ static uint8_t AllocateIntoCache(int bytes, int lumpnum) {
             #if TH_CANARY_ENABLED == 1
             printf("INFO: Not enough contiguous memory - trying defragmentation\n");
             #endif
-            TH_defrag(defrag_cb);
+            Defrag();
             if (!TH_checkhealth_verbose()) {
                 #if TH_CANARY_ENABLED == 1
                 printf("FATAL: Heap corrupted during defragmentation\n");
@@ -296,8 +847,11 @@ static uint8_t AllocateIntoCache(int bytes, int lumpnum) {
             data = TH_alloc(bytes,lumpnum);
             if (!data) {
                 // Still not working - try to evict one and then try defrag and alloc again
-                // (since data is null)
-                if (!EvictOne()) {
+                // (since data is null). Pending prefetches pin their entries, so finish them first.
+                // What the epoch holds stays pinned until NC_EndEpoch().
+                if (pfinflight) {
+                    DrainPrefetch();
+                } else if (!EvictOne()) {
                     // Now this is bad - we cant evict any more and we can't allocate. 
                     #if TH_CANARY_ENABLED == 1
                     printf("FATAL: Can't allocate %d bytes for lumpnum=%d\n",bytes,lumpnum);
@@ -328,8 +882,10 @@ static uint8_t AllocateIntoCache(int bytes, int lumpnum) {
     lru[0].free = lru[entry].free;
     // Put it into pointers
     pointers[entry]=data;
+    pagemask[entry]=0xffffffff;
     // Insert in front in the LRU.
     InsertInFrontOfLRU(entry);
+    PolicyInsert(entry,bytes);
     cache[lumpnum]=entry;
     allocated += bytes;
     #if TH_CANARY_ENABLED == 1
@@ -352,19 +908,304 @@ static filelump_t LumpForNum(int lumpnum){
     return data;
 }
 
+/**
+ * Packed WADs (NC_PACKED_WAD): a packed lump is read into the end of a block WADPACK_MARGIN bytes
+ * larger than the lump, and decompressed in place from there. The packer has checked that this
+ * never overwrites bytes before they are read. These helpers give the packed size (0 when the
+ * lump is stored as it is), the block size, and the bytes read from the WAD and where they go.
+ */
+static inline int PackedSize(int lumpnum UNUSED) {
+    #if NC_PACKED_WAD == 1
+    return LC_PackedSize(lumpnum);
+    #else
+    return 0;
+    #endif
+}
+
+static inline int BlockSize(const filelump_t &lump, int packed) {
+    return packed ? lump.size+WADPACK_MARGIN : lump.size;
+}
+
+static inline int FileSize(const filelump_t &lump, int packed) {
+    return packed ? packed : lump.size;
+}
+
+static inline uint8_t * ReadDst(uint8_t *block, const filelump_t &lump, int packed) {
+    return block+BlockSize(lump,packed)-FileSize(lump,packed);
+}
+
+/**
+ * Decompress an LZ4 block of len bytes at src into dst
+ */
+static void Unpack(uint8_t *dst, const uint8_t *src, int len) {
+    const uint8_t *end = src+len;
+    for (;;) {
+        unsigned token = *src++;
+        unsigned n = token >> 4;
+        if (n == 15) {
+            unsigned more;
+            do {
+                more = *src++;
+                n += more;
+            } while (more == 255);
+        }
+        // Literals move towards the start of the block, which memmove handles
+        memmove(dst,src,n);
+        dst += n;
+        src += n;
+        if (src >= end) return;
+        const uint8_t *from = dst - (src[0] | (src[1] << 8));
+        src += 2;
+        n = token & 15;
+        if (n == 15) {
+            unsigned more;
+            do {
+                more = *src++;
+                n += more;
+            } while (more == 255);
+        }
+        n += 4;
+        // Matches may overlap what they produce, so copy a byte at a time
+        while (n--) *dst++ = *from++;
+    }
+}
+
+/**
+ * Decompress lumpnum if it is packed, once its block has been read
+ */
+static void UnpackLump(uint8_t *block, int lumpnum) {
+    int packed = PackedSize(lumpnum);
+    if (!packed) return;
+    auto lump = LumpForNum(lumpnum);
+    Unpack(block,ReadDst(block,lump,packed),packed);
+}
+
+/**
+ * Read from the WAD file. When the loader thread is running, it shares the flash device with
+ * the game thread so reads are serialized.
+ */
+static void ReadLump(uint8_t *dst, int offset, int len) {
+    #if NC_PREFETCH_THREADED == 1
+    std::lock_guard<std::mutex> guard(wrlock);
+    #endif
+    WR_Read(dst,offset,len);
+}
+
+/**
+ * Read a whole lump into its block and unpack it. Returns the number of bytes read.
+ */
+static int LoadLump(uint8_t *block, int lumpnum, const filelump_t &lump) {
+    int packed = PackedSize(lumpnum);
+    ReadLump(ReadDst(block,lump,packed),lump.filepos,FileSize(lump,packed));
+    UnpackLump(block,lumpnum);
+    return FileSize(lump,packed);
+}
+
+/**
+ * Read a batch of lumps sorted on file position, letting the reader merge neighbours
+ */
+static void ReadLumps(const wr_request_t *reqs, int count) {
+    #if NC_PREFETCH_THREADED == 1
+    std::lock_guard<std::mutex> guard(wrlock);
+    #endif
+    WR_ReadV(reqs,count);
+}
+
+/**
+ * Insert a request into a batch kept sorted on file position
+ */
+static void AddToBatch(wr_request_t *batch, int n, uint8_t *dst, int offset, int len) {
+    int j = n;
+    while (j > 0 && batch[j-1].offset > offset) {
+        batch[j] = batch[j-1];
+        j--;
+    }
+    batch[j].dst = dst;
+    batch[j].offset = offset;
+    batch[j].len = len;
+}
+
+/**
+ * Carry out the queued prefetch requests from slot first up to slot last as one batch. This is 
+ * the loader's half of the queue.
+ */
+static void LoadPrefetches(unsigned first, unsigned last) {
+    wr_request_t batch[NC_PREFETCH_QUEUE];
+    const prefetch_t *loaded[NC_PREFETCH_QUEUE];
+    int n = 0;
+    for (unsigned i=first; i!=last; i++) {
+        const prefetch_t *req = &pfqueue[i & (NC_PREFETCH_QUEUE-1)];
+        #if NC_PREFETCH_THREADED != 1
+        // Skip requests that were completed on access. Their slot is cancelled then, but the entry
+        // and its block may have been reused since, so check that the request still owns them.
+        if (!req->entry || pfstate[req->entry] != PF_QUEUED || cache[req->lumpnum] != req->entry ||
+            pointers[req->entry] != req->block) continue;
+        #endif
+        AddToBatch(batch,n,req->dst,req->offset,req->len);
+        loaded[n++] = req;
+    }
+    ReadLumps(batch,n);
+    for (int i=0; i<n; i++) {
+        UnpackLump(loaded[i]->block,loaded[i]->lumpnum);
+        #if NC_PREFETCH_THREADED == 1
+        pfstate[loaded[i]->entry].store(PF_LOADED,std::memory_order_release);
+        #else
+        pfstate[loaded[i]->entry] = PF_LOADED;
+        #endif
+    }
+}
+
+#if NC_PREFETCH_THREADED == 1
+/**
+ * Background loader. Sleeps until the game thread queues requests and then loads them in order.
+ */
+static void LoaderMain() {
+    for (;;) {
+        unsigned head = pfhead.load(std::memory_order_relaxed);
+        if (head == pftail.load(std::memory_order_acquire)) {
+            std::unique_lock<std::mutex> sleep(pfwakelock);
+            pfwake.wait(sleep,[head]{return head != pftail.load(std::memory_order_acquire);});
+            continue;
+        }
+        // Take everything that is queued in one go
+        unsigned tail = pftail.load(std::memory_order_acquire);
+        LoadPrefetches(head,tail);
+        pfhead.store(tail,std::memory_order_release);
+    }
+}
+#endif
+
+/**
+ * Make sure a prefetched entry has its data and release the pin that NC_Prefetch() took
+ */
+static void CompletePrefetch(nc_entry_t entry) {
+    #if NC_PREFETCH_THREADED == 1
+    while (pfstate[entry].load(std::memory_order_acquire) == PF_QUEUED) {
+        std::this_thread::yield();
+    }
+    #else
+    if (pfstate[entry] == PF_QUEUED) {
+        // Not serviced yet - load it here and cancel the queue slot, as once unpinned the entry
+        // may be evicted or moved and then queued again before the slot is serviced
+        int lumpnum = lumpnum_for_ptr(pointers[entry]);
+        LoadLump(pointers[entry],lumpnum,LumpForNum(lumpnum));
+        for (unsigned i=pfhead; i!=pftail; i++) {
+            prefetch_t *req = &pfqueue[i & (NC_PREFETCH_QUEUE-1)];
+            if (req->entry == entry) req->entry = 0;
+        }
+    }
+    #endif
+    pfstate[entry] = PF_IDLE;
+    pfinflight--;
+    assert(pincount[entry]>0);
+    pincount[entry]-=1;
+}
+
+/**
+ * Release the pins of all requests the loader has completed
+ */
+static void ReapPrefetch() {
+    #if NC_PREFETCH_THREADED == 1
+    unsigned head = pfhead.load(std::memory_order_acquire);
+    #else
+    unsigned head = pfhead;
+    #endif
+    while (pfreap != head) {
+        const prefetch_t *req = &pfqueue[pfreap & (NC_PREFETCH_QUEUE-1)];
+        // Entries already completed by an access are idle, or possibly reused by a new request
+        if (req->entry && pfstate[req->entry] == PF_LOADED) 
+            CompletePrefetch(req->entry);
+        pfreap++;
+    }
+}
+
+/**
+ * Perform queued prefetches if there is no loader thread, and release the pins of the
+ * ones that are done
+ */
+static void ServicePrefetch() {
+    #if NC_PREFETCH_THREADED != 1
+    if (pfhead != pftail) {
+        LoadPrefetches(pfhead,pftail);
+        pfhead = pftail;
+    }
+    #endif
+    ReapPrefetch();
+}
+
+/**
+ * Wait for (or perform) all outstanding prefetches and release their pins
+ */
+static void DrainPrefetch() {
+    #if NC_PREFETCH_THREADED == 1
+    while (pfhead.load(std::memory_order_acquire) != pftail.load(std::memory_order_relaxed)) {
+        std::this_thread::yield();
+    }
+    #endif
+    ServicePrefetch();
+}
+
+/**
+ * Add lumpnum to the manifest being recorded unless it is there already
+ */
+static void TraceMiss(int lumpnum) {
+    if (lumpnum >= WADLUMPS || (traced[lumpnum>>3] & (1<<(lumpnum&7)))) return;
+    traced[lumpnum>>3] |= 1<<(lumpnum&7);
+    if (tracing->count < NC_TRACE_LUMPS)
+        tracing->lumps[tracing->count++] = lumpnum;
+}
+
+/**
+ * Size of the pages of a lump - NC_PAGE_SIZE unless that would make more than 32 of them
+ */
+static int PageSize(int size) {
+    int pagesize = (size+31)/32;
+    return (pagesize+NC_PAGE_SIZE-1) & ~(NC_PAGE_SIZE-1);
+}
+
+/**
+ * Read the pages of entry that cover [offset,offset+len) and aren't loaded yet. Each run of
+ * missing pages is read in one go.
+ */
+static void FillPages(nc_entry_t entry, const filelump_t &lump, int offset, int len) {
+    int pagesize = PageSize(lump.size);
+    int npages = (lump.size+pagesize-1)/pagesize;
+    int last = (offset+len-1)/pagesize;
+    if (last >= npages) last = npages-1;
+    for (int page = offset/pagesize; page <= last; ) {
+        if (pagemask[entry] & (1u<<page)) {
+            page++;
+            continue;
+        }
+        int end = page;
+        while (end < last && !(pagemask[entry] & (1u<<(end+1)))) end++;
+        int from = page*pagesize;
+        int to = (end+1)*pagesize;
+        if (to > lump.size) to = lump.size;
+        ReadLump(pointers[entry]+from,lump.filepos+from,to-from);
+        stats.bytesread += to-from;
+        for (; page <= end; page++) pagemask[entry] |= 1u<<page;
+    }
+    uint32_t complete = (npages == 32) ? 0xffffffff : (1u<<npages)-1;
+    if (pagemask[entry] == complete) pagemask[entry] = 0xffffffff;
+}
+
 /**
  * Make sure that lumpnum is mapped and loaded in the cache and return the pointer to the lump data.
  */
-const uint8_t * NC_CacheLumpNum(int lumpnum)
+static const uint8_t * CacheLumpNum(int lumpnum)
 {
     ASSERT_VALID_LUMPNUM_OR_MINUS1(lumpnum);
     if (cache[lumpnum]==0){
         // Allocate new cache entry and load it from file
         auto lump = LumpForNum(lumpnum);
-        uint8_t entry = AllocateIntoCache(lump.size,lumpnum);
-        auto ptr = pointers[entry];
-        // Read the header
-        WR_Read(ptr,lump.filepos,lump.size);    
+        nc_entry_t entry = AllocateIntoCache(BlockSize(lump,PackedSize(lumpnum)),lumpnum);
+        stats.misses++;
+        stats.bytesread += LoadLump(pointers[entry],lumpnum,lump);
+        #if NC_STATS_LUMPMISSES == 1
+        if (lumpmisses[lumpnum] != 0xffff) lumpmisses[lumpnum]++;
+        #endif
+        if (tracing) TraceMiss(lumpnum);
         #if TH_CANARY_ENABLED == 1
         if (TH_checkhealth_verbose()==false) {
             printf("FATAL: Heap corrupted after loading lump %d\n",lumpnum);
@@ -375,13 +1216,241 @@ const uint8_t * NC_CacheLumpNum(int lumpnum)
         #endif
         //printf("!");
         //fflush(stdout);
-    } 
+    } else {
+        stats.hits++;
+    }
     auto entry = cache[lumpnum];
     ASSERT_VALID_CACHE_ENTRY(entry);
+    MarkUsed(entry);
+    if (pfinflight && pfstate[entry] != PF_IDLE) {
+        CompletePrefetch(entry);
+    }
+    if (pagemask[entry] != 0xffffffff) {
+        // Only parts of it were needed so far
+        auto lump = LumpForNum(lumpnum);
+        FillPages(entry,lump,0,lump.size);
+    }
     auto ptr = pointers[entry];
     return ptr;
 }  
 
+const uint8_t * NC_CacheLumpNum(int lumpnum)
+{
+    TRACE_ACCESS(NC_TRACE_CACHE,lumpnum);
+    return CacheLumpNum(lumpnum);
+}
+
+/**
+ * Allocate room for lumpnum and queue it for loading, so that a later access finds it resident.
+ * This is a hint only - it is dropped if the lump is already cached or the queue is full.
+ */
+void NC_Prefetch(int lumpnum)
+{
+    ASSERT_VALID_LUMPNUM_OR_MINUS1(lumpnum);
+    TRACE_ACCESS(NC_TRACE_PREFETCH,lumpnum);
+    if (lumpnum < 0 || lumpnum >= WADLUMPS || cache[lumpnum]) return;
+    #if NC_PREFETCH_THREADED == 1
+    unsigned tail = pftail.load(std::memory_order_relaxed);
+    #else
+    unsigned tail = pftail;
+    #endif
+    if (tail - pfreap >= NC_PREFETCH_QUEUE) {
+        // Make room by releasing what the loader is done with
+        ReapPrefetch();
+        if (tail - pfreap >= NC_PREFETCH_QUEUE) return;
+    }
+    auto lump = LumpForNum(lumpnum);
+    int packed = PackedSize(lumpnum);
+    nc_entry_t entry = AllocateIntoCache(BlockSize(lump,packed),lumpnum);
+    // Hold a pin until the data is there so the block can't be evicted or moved by a defrag
+    pincount[entry]+=1;
+    pfstate[entry] = PF_QUEUED;
+    pfinflight++;
+    prefetch_t *req = &pfqueue[tail & (NC_PREFETCH_QUEUE-1)];
+    req->block = pointers[entry];
+    req->dst = ReadDst(pointers[entry],lump,packed);
+    req->offset = lump.filepos;
+    req->len = FileSize(lump,packed);
+    req->lumpnum = lumpnum;
+    req->entry = entry;
+    stats.bytesread += req->len; // Counted here as the loader thread may do the read
+    #if NC_PREFETCH_THREADED == 1
+    pftail.store(tail+1,std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> wake(pfwakelock);
+    }
+    pfwake.notify_one();
+    #else
+    pftail = tail+1;
+    #endif
+}
+
+/**
+ * Load the head of a manifest - as much as fits in NC_PRELOAD_BYTES - sorted by file
+ * position so that the flash is read in one forward pass
+ */
+static void Preload(const manifest_t *manifest) {
+    wr_request_t batch[NC_TRACE_LUMPS];
+    nc_entry_t entries[NC_TRACE_LUMPS];
+    int n = 0;
+    int bytes = 0;
+    for (int i=0; i<manifest->count; i++) {
+        int lumpnum = manifest->lumps[i];
+        if (cache[lumpnum]) continue;
+        auto lump = LumpForNum(lumpnum);
+        int packed = PackedSize(lumpnum);
+        if (bytes + BlockSize(lump,packed) > NC_PRELOAD_BYTES) break;
+        bytes += BlockSize(lump,packed);
+        // Pinned until the batch has been read, so later allocations can't evict or move it
+        nc_entry_t entry = AllocateIntoCache(BlockSize(lump,packed),lumpnum);
+        pincount[entry]+=1;
+        entries[n] = entry;
+        AddToBatch(batch,n++,ReadDst(pointers[entry],lump,packed),lump.filepos,FileSize(lump,packed));
+        stats.misses++;
+        stats.bytesread += FileSize(lump,packed);
+    }
+    // One pass over the WAD in file order
+    ReadLumps(batch,n);
+    for (int i=0; i<n; i++) {
+        UnpackLump(pointers[entries[i]],lumpnum_for_ptr(pointers[entries[i]]));
+        pincount[entries[i]]-=1;
+    }
+    #if TH_CANARY_ENABLED == 1
+    printf("INFO: Preloaded %d of %d lumps (%d bytes) for map lump %d\n",n,manifest->count,bytes,manifest->maplump);
+    #endif
+}
+
+/**
+ * Called when a new map has been selected and the cache has been flushed. Warms the cache
+ * from the manifest of maplump if there is one, and starts recording the misses of the first
+ * tics. On a replay, lumps that miss but aren't in the manifest are appended to it.
+ */
+void NC_BeginLevel(int maplump)
+{
+    TRACE_ACCESS(NC_TRACE_LEVEL,maplump);
+    levelmap = maplump;
+    manifest_t *manifest = nullptr;
+    for (int i=0; i<NC_TRACE_MAPS; i++) {
+        if (manifests[i].maplump == maplump) manifest = &manifests[i];
+    }
+    memset(traced,0,sizeof(traced));
+    if (manifest) {
+        Preload(manifest);
+        for (int i=0; i<manifest->count; i++)
+            traced[manifest->lumps[i]>>3] |= 1<<(manifest->lumps[i]&7);
+    } else {
+        manifest = &manifests[nextmanifest];
+        nextmanifest = (nextmanifest+1) % NC_TRACE_MAPS;
+        manifest->maplump = maplump;
+        manifest->count = 0;
+    }
+    tracing = manifest;
+    tracetics = NC_TRACE_TICS;
+}
+
+/**
+ * Called once per game tic to count the tics of play and end the recording after NC_TRACE_TICS
+ */
+void NC_LevelTic(void)
+{
+    TRACE_ACCESS(NC_TRACE_TIC,0);
+    gametic++;
+    if (tracing && --tracetics <= 0)
+        tracing = nullptr;
+}
+
+/**
+ * Cumulative telemetry counters
+ */
+const nc_stats_t* NC_GetStats(void)
+{
+    return &stats;
+}
+
+/**
+ * Number of times lumpnum has been loaded on a miss (0 if per lump counting is disabled)
+ */
+int NC_GetLumpMisses(int lumpnum)
+{
+    ASSERT_VALID_LUMPNUM(lumpnum);
+    #if NC_STATS_LUMPMISSES == 1
+    return lumpmisses[lumpnum];
+    #else
+    return 0;
+    #endif
+}
+
+/**
+ * Close the current frame: store its activity in the frame ring and start a new one
+ */
+void NC_EndFrame(void)
+{
+    TRACE_ACCESS(NC_TRACE_FRAME,0);
+    nc_stats_t *frame = &framestats[stats.frame % NC_STATS_FRAMES];
+    frame->frame = stats.frame;
+    frame->hits = stats.hits - framestart.hits;
+    frame->misses = stats.misses - framestart.misses;
+    frame->evictions = stats.evictions - framestart.evictions;
+    frame->defrags = stats.defrags - framestart.defrags;
+    frame->defragbytes = stats.defragbytes - framestart.defragbytes;
+    frame->bytesread = stats.bytesread - framestart.bytesread;
+    stats.flashus = WR_FlashTime();
+    frame->flashus = stats.flashus - framestart.flashus;
+    stats.frame++;
+    framestart = stats;
+}
+
+/**
+ * Fetch the activity of a finished frame, age 0 being the most recent one. Returns false if
+ * the frame has dropped out of the ring (or hasn't happened yet).
+ */
+bool NC_GetFrameStats(int age, nc_stats_t *dst)
+{
+    if (age < 0 || age >= NC_STATS_FRAMES || (uint32_t)age >= stats.frame) return false;
+    *dst = framestats[(stats.frame - 1 - age) % NC_STATS_FRAMES];
+    return true;
+}
+
+/**
+ * Fill in the lump and pinned state of a heap block for TH_snapshot(). Object blocks and
+ * blocks that aren't what the cache maps for their lump are left alone.
+ */
+void NC_DescribeBlock(uint8_t *ptr, th_blockinfo_t *info)
+{
+    if (info->tag & 0x80000000) return;
+    int lumpnum = (int)info->tag;
+    if (lumpnum >= MAXLUMPS) return;
+    auto entry = cache[lumpnum];
+    if (!entry || pointers[entry] != ptr) return;
+    info->lump = (int16_t)lumpnum;
+    if (pincount[entry]) info->flags |= TH_BLOCK_PINNED;
+}
+
+/**
+ * Give the prefetch machinery a chance to run. Without a loader thread this is where queued
+ * requests are read from flash, so call it when the game is otherwise idle. In all cases 
+ * finished requests are released so that their entries become evictable again.
+ */
+void NC_ServicePrefetch(void)
+{
+    TRACE_ACCESS(NC_TRACE_SERVICE,0);
+    ServicePrefetch();
+}
+
+/**
+ * Spend a bounded amount of work compacting the cache. Meant to be called once per frame when
+ * the game has time to spare; a pass is spread over as many calls as it takes.
+ */
+void NC_IdleDefrag(void)
+{
+    TRACE_ACCESS(NC_TRACE_IDLEDEFRAG,0);
+    if (!fragmented) return;
+    if (TH_defrag_step(defrag_cb,NC_IDLE_DEFRAG_BYTES)) {
+        stats.defrags++;
+        fragmented = false;
+    }
+}
+
 /**
  * Return the size of the lump indexed by lumpnum, either by looking in the cache or by loading the
  * lump descriptor from the WAD file using LumpForNum and get the size from there.
@@ -391,7 +1460,7 @@ int NC_LumpLength(int lumpnum)
     ASSERT_VALID_LUMPNUM(lumpnum);
     /*
     // Grab length from cache if the element is already cached.
-    uint8_t entry = cache[lumpnum];
+    nc_entry_t entry = cache[lumpnum];
     if (entry) {
         return size_for_ptr(pointers[entry]);
     }
@@ -470,8 +1539,21 @@ void NC_Init(void)
     LC_Init();
     // Permanently pin lumps that are allocated in normal RAM
     InitCache();
+    PolicyInit();
+    // What epochs hold must leave room for two of the largest lumps pinned the normal way,
+    // as a map's SEGS and LINEDEFS are, plus the headers and the slack tagheap asks for
+    for (int i=0; i<WADLUMPS; i++) {
+        int bytes = 2*(BlockSize(LumpForNum(i),PackedSize(i)) + sizeof(th_memblock_t) + 32);
+        if (bytes > epochreserve) epochreserve = bytes;
+    }
     // Read the header
     WR_Read((uint8_t *)&header,0,sizeof(header));
+    #if NC_PREFETCH_THREADED == 1
+    std::thread(LoaderMain).detach();
+    #endif
+    #if NC_ACCESSTRACE == 1
+    accesstrace = fopen(NC_ACCESSTRACE_FILE,"wb");
+    #endif
 }
 
 /**
@@ -511,23 +1593,63 @@ void NC_ExtractFileBase(const char* path, char* dest)
 const uint8_t * NC_Pin(int lumpnum)
 {
     ASSERT_VALID_LUMPNUM_OR_MINUS1(lumpnum);
-    auto data = NC_CacheLumpNum(lumpnum);
+    TRACE_ACCESS(NC_TRACE_PIN,lumpnum);
+    auto data = CacheLumpNum(lumpnum);
     auto entry = cache[lumpnum];
     ASSERT_VALID_CACHE_ENTRY(entry);
     //printf("Pinning lump %d from entry %d at address 0x%lx\n",lumpnum_for_ptr(data),entry,(uintptr_t)data);
     pincount[entry]+=1;
-    // Move entry up front in the LRU
-    RemoveEntryFromLRU(entry);
-    InsertInFrontOfLRU(entry);
+    PolicyTouch(entry);
     return data;
 }
 
+/**
+ * Pin a lump like NC_Pin(), but only guarantee that the bytes [offset,offset+len) are loaded. Large lumps
+ * are then read page by page as ranges of them are needed. The pin is released with NC_Unpin().
+ */
+const uint8_t * NC_PinRange(int lumpnum, int offset, int len)
+{
+    ASSERT_VALID_LUMPNUM(lumpnum);
+    TRACE_RANGE(lumpnum,offset,len);
+    auto entry = cache[lumpnum];
+    if (entry && pagemask[entry] == 0xffffffff) {
+        // Resident - this is an ordinary pin
+        CacheLumpNum(lumpnum);
+    } else {
+        auto lump = LumpForNum(lumpnum);
+        if (!entry && (lump.size < NC_PAGED_MIN || PackedSize(lumpnum))) {
+            // Not worth paging, or packed so that it can only be read as a whole
+            CacheLumpNum(lumpnum);
+        } else {
+            if (!entry) {
+                entry = AllocateIntoCache(lump.size,lumpnum);
+                pagemask[entry] = 0;
+                #if NC_STATS_LUMPMISSES == 1
+                if (lumpmisses[lumpnum] != 0xffff) lumpmisses[lumpnum]++;
+                #endif
+                if (tracing) TraceMiss(lumpnum);
+            }
+            MarkUsed(entry);
+            auto before = stats.bytesread;
+            FillPages(entry,lump,offset,len);
+            if (stats.bytesread != before) stats.misses++;
+            else stats.hits++;
+        }
+    }
+    entry = cache[lumpnum];
+    ASSERT_VALID_CACHE_ENTRY(entry);
+    pincount[entry]+=1;
+    PolicyTouch(entry);
+    return pointers[entry]+offset;
+}
+
 /**
  * Unpin the lump by decreasing its pincount
  */
 void NC_Unpin(int lumpnum)
 {
     ASSERT_VALID_LUMPNUM_OR_MINUS1(lumpnum);
+    TRACE_ACCESS(NC_TRACE_UNPIN,lumpnum);
     //printf("Unpin lump %d\n",lumpnum);
     auto entry = cache[lumpnum];
     ASSERT_VALID_CACHE_ENTRY(entry);
@@ -535,6 +1657,171 @@ void NC_Unpin(int lumpnum)
     pincount[entry]-=1;    
 }   
 
+/**
+ * Drop the pins held by the current epoch
+ */
+static void ReleaseEpoch() {
+    for (int i=0; i<epochcount; i++) {
+        auto entry = epochpins[i];
+        nc_epochptrs[lumpnum_for_ptr(pointers[entry])+1] = nullptr;
+        pincount[entry] -= 1;
+    }
+    epochcount = 0;
+    epochbytes = 0;
+    epochnruns = -1;
+}
+
+/**
+ * Find the runs of cache heap blocks of at least epochreserve bytes that could be evicted or
+ * moved. Pinned blocks end a run.
+ */
+static void FindMovableRuns() {
+    epochnruns = 0;
+    const uint8_t *start = th_heap;
+    for (auto block = (th_memblock_t *)th_heap; block; block = TH_next(block)) {
+        // Pinned blocks and the end marker end a run. Blocks that aren't mapped can move.
+        bool fixed = !TH_next(block) || (TH_tag(block) != TH_FREE_TAG && pincount[cache[TH_tag(block)]]);
+        if (!fixed) continue;
+        auto end = (const uint8_t *)block;
+        if (end - start >= epochreserve && epochnruns < NC_EPOCH_RUNS) {
+            epochruns[epochnruns][0] = start;
+            epochruns[epochnruns][1] = end;
+            epochnruns++;
+        }
+        if (TH_next(block)) start = (const uint8_t *)TH_next(block);
+    }
+}
+
+/**
+ * Whether a run of at least epochreserve bytes is left if the block holding ptr is pinned. When
+ * split is set the runs are updated as if it were.
+ */
+static bool LeavesMovableRun(const uint8_t *ptr, bool split) {
+    auto block = (const th_memblock_t *)ptr - 1;
+    auto lo = (const uint8_t *)block;
+    auto hi = (const uint8_t *)TH_next(block);
+    const uint8_t *runs[NC_EPOCH_RUNS][2];
+    int n = 0;
+    bool room = false;
+    for (int i=0; i<epochnruns; i++) {
+        auto start = epochruns[i][0];
+        auto end = epochruns[i][1];
+        if (lo < start || lo >= end) {
+            // A run elsewhere is left as it is
+            room = true;
+            if (n < NC_EPOCH_RUNS) {
+                runs[n][0] = start;
+                runs[n++][1] = end;
+            }
+            continue;
+        }
+        // The run is split around the block, keep the pieces that are still big enough
+        if (lo - start >= epochreserve) {
+            room = true;
+            if (n < NC_EPOCH_RUNS) {
+                runs[n][0] = start;
+                runs[n++][1] = lo;
+            }
+        }
+        if (end - hi >= epochreserve) {
+            room = true;
+            if (n < NC_EPOCH_RUNS) {
+                runs[n][0] = hi;
+                runs[n++][1] = end;
+            }
+        }
+    }
+    if (split) {
+        memcpy(epochruns,runs,sizeof(runs));
+        epochnruns = n;
+    }
+    return room;
+}
+
+/**
+ * Start an epoch (a frame or a tic). Until the matching NC_EndEpoch() the lumps accessed 
+ * through NC_EpochPtr() stay where they are, so proxies can use plain pointers to them.
+ * Epochs nest - only the outermost one releases the pins.
+ */
+void NC_BeginEpoch(void)
+{
+    TRACE_ACCESS(NC_TRACE_BEGINEPOCH,0);
+    if (epochdepth == 0) {
+        if (++epochgen == 0) {
+            memset(epochtried,0,sizeof(epochtried));
+            epochgen = 1;
+        }
+        epochcalm = stats.evictions == epochevictions ? epochcalm+1 : 0;
+        epochevictions = stats.evictions;
+    }
+    epochdepth++;
+    nc_epochactive = true;
+}
+
+void NC_EndEpoch(void)
+{
+    TRACE_ACCESS(NC_TRACE_ENDEPOCH,0);
+    assert(epochdepth>0);
+    if (--epochdepth == 0) {
+        ReleaseEpoch();
+        nc_epochactive = false;
+    }
+}
+
+/**
+ * Return the address of a lump that stays valid until the epoch ends. The first access in an epoch
+ * pins the lump, after that it is a table lookup that the proxies make inline. Returns nullptr
+ * outside an epoch, when the lump isn't resident, or when the epoch can't hold more lumps, and the
+ * caller must then pin the lump the normal way. Only the access that holds the lump is counted. A
+ * lump that missed is held from its next access on, when it is known where it landed.
+ */
+const uint8_t * NC_EpochPtr(int lumpnum)
+{
+    ASSERT_VALID_LUMPNUM_OR_MINUS1(lumpnum);
+    TRACE_ACCESS(NC_TRACE_EPOCHPTR,lumpnum);
+    auto data = nc_epochptrs[lumpnum+1];
+    if (data || !nc_epochactive || epochcount == NC_EPOCH_PINS) return data;
+    if (epochcalm < NC_EPOCH_CALM || stats.evictions != epochevictions) return nullptr;
+    auto entry = cache[lumpnum];
+    if (!entry || entry >= NC_ENTRY_JUNK || epochtried[entry] == epochgen) return nullptr;
+    ASSERT_VALID_CACHE_ENTRY(entry);
+    if (epochnruns < 0) FindMovableRuns();
+    int size = size_for_ptr(pointers[entry]);
+    if (epochbytes + size > NC_EPOCH_BYTES || !LeavesMovableRun(pointers[entry],false)) {
+        epochtried[entry] = epochgen;
+        return nullptr;
+    }
+    data = CacheLumpNum(lumpnum);
+    LeavesMovableRun(data,true);
+    epochbytes += size;
+    pincount[entry]+=1;
+    PolicyTouch(entry);
+    nc_epochptrs[lumpnum+1] = data;
+    epochpins[epochcount++] = entry;
+    return data;
+}
+
+/**
+ * What the proxies call when a lump isn't held: NC_CacheLumpNum(), but inside an epoch the lump is
+ * held first if it can be, so that the next access finds it inline
+ */
+const uint8_t * NC_EpochCacheLumpNum(int lumpnum)
+{
+    auto data = NC_EpochPtr(lumpnum);
+    return data ? data : NC_CacheLumpNum(lumpnum);
+}
+
+/**
+ * As NC_EpochCacheLumpNum(), for proxies that need the lump to stay put. A lump that isn't held is
+ * pinned, and then pinned is set and the caller must NC_Unpin() it.
+ */
+const uint8_t * NC_EpochPin(int lumpnum, bool *pinned)
+{
+    auto data = NC_EpochPtr(lumpnum);
+    *pinned = !data;
+    return data ? data : NC_Pin(lumpnum);
+}
+
 /**
  * Flush the cache by evicting all objects (could be done faster and more brute force, but this is easier to debug)
  */
@@ -546,7 +1833,11 @@ void NC_FlushCache(void)
     printf("******************\n");
     printf("Flushing cache with %d bytes in it\n",allocated);
     #endif
+    TRACE_ACCESS(NC_TRACE_FLUSH,0);
 
+    // Everything goes, including what the current epoch holds
+    ReleaseEpoch();
+    DrainPrefetch();
     while (EvictOne());
 
     #if TH_CANARY_ENABLED == 1
@@ -558,4 +1849,29 @@ void NC_FlushCache(void)
     #endif
 }
 
+/**
+ * Called when the data of a level is freed. Unlike NC_FlushCache() it only evicts the lumps of
+ * the map and those that went cold, so that the next map doesn't start with a storm of misses
+ * for what it shares with this one.
+ */
+void NC_EndLevel(void)
+{
+    TRACE_ACCESS(NC_TRACE_ENDLEVEL,0);
+    ReleaseEpoch();
+    DrainPrefetch();
+    for (int entry=1; entry<NC_ENTRY_JUNK; entry++) {
+        if (!pointers[entry] || pincount[entry]) continue;
+        int lumpnum = lumpnum_for_ptr(pointers[entry]);
+        bool maplump = levelmap >= 0 && lumpnum > levelmap && lumpnum <= levelmap+ML_BLOCKMAP;
+        bool cold = (uint16_t)(gametic - lastused[entry]) > NC_WARM_TICS;
+        if (maplump || cold) EvictEntry(entry);
+    }
+    levelmap = -1;
+    // Loading the level is a good time to compact what is kept
+    if (fragmented) Defrag();
+    #if TH_CANARY_ENABLED == 1
+    printf("Kept %d bytes in the cache for the next level\n",allocated);
+    #endif
+}
+
 
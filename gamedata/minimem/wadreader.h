@@ -3,7 +3,28 @@
 
 #include <stdint.h>
 
+// The file read by the host readers
+#ifndef WR_WADFILE
+#if NC_PACKED_WAD == 1
+#define WR_WADFILE "gbadoom1z.wad"
+#else
+#define WR_WADFILE "gbadoom1.wad"
+#endif
+#endif
+
+// One part of a batched read
+typedef struct {
+    uint8_t *dst;
+    int offset;
+    int len;
+} wr_request_t;
+
 void WR_Init();
 void WR_Read(uint8_t *dst, int offset, int len);
+// Read a batch of requests sorted on offset. Neighbouring requests may be served by a single
+// sequential transaction, so a batch is cheaper than the same reads done one by one.
+void WR_ReadV(const wr_request_t *reqs, int count);
+// Microseconds spent in reads since WR_Init() on readers that emulate flash timing, 0 on others
+uint32_t WR_FlashTime();
 
-#endif //__wadreader_h
\ No newline at end of file
+#endif //__wadreader_h
@@ -67,16 +67,21 @@ void * Z_Malloc(int size, int tag, void **user) {
 }
 
 /**
- * Z_Free replacement
+ * Clear the pointer that owns the block of user data at userptr, if it has one
  */
-void Z_Free(void *ptr) {
-    auto userptr = (void **)((uint8_t *)ptr - sizeof(void**));
-    if (userptr > (void**)0x100) {
-        void **user = (void **)(*userptr);
+static void ClearUser(uint8_t *userptr) {
+    if ((void **)userptr > (void**)0x100) {
+        void **user = (void **)(*(void **)userptr);
         if (user && user > (void **)0x100)
             *user = nullptr;
     }
+}
 
+/**
+ * Z_Free replacement
+ */
+void Z_Free(void *ptr) {
+    ClearUser((uint8_t *)ptr - sizeof(void**));
     TH_free((uint8_t *)ptr-sizeof(void**));
 }
 
@@ -120,21 +125,13 @@ void * Z_Calloc(size_t count, size_t size, int tag, void **user) {
 }
 
 /**
- * Z_FreeTags replacement
+ * Z_FreeTags replacement. All owners are cleared before anything is freed, as an owner may
+ * live in another block that goes in the same sweep.
  */
 void Z_FreeTags(int lowtag, int hightag) {
-    unsigned tag = 0x80000000;
-    th_memblock_t *block = FIRSTBLOCK;
     unsigned lt = lowtag | 0x80000000;
     unsigned ht = hightag | 0x80000000;
-    while (block) {
-        auto userptr = (uint8_t *)(block+1);
-        auto ptr = userptr + sizeof(void**);
-        if (lt <= block->tag && block->tag <= ht) {
-            Z_Free(ptr);
-        }
-        block = block->next;
-    }
+    TH_freetags_cb(lt, ht, ClearUser);
 }
 
 void Z_Init() {
@@ -0,0 +1,236 @@
+#include "../newcache/newcache.h"
+#include "../include/annotations.h"
+#include "../include/r_defs.h"
+#include "../minimem/w_lumps.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+extern unsigned char gfx_stbar[];
+extern line_t junk;
+
+/**
+ * This file contains a cache for hosts with an operating system: the WAD file is mapped into
+ * memory and lumps are returned as pointers straight into the mapping. Nothing is copied,
+ * nothing is ever evicted or moved and so pinning is a no-op. Every lump is held by a permanent
+ * epoch, so the proxies find their pointers inline and never call in.
+ *
+ * Lump names are looked up through the tables in minimem/w_lumps, which are generated from
+ * the same WAD file. Level objects still live in the tagheap through minimem/z_mem_emu.
+ */
+
+#if NC_PACKED_WAD == 1
+#error "Lumps are used where they are in the mapping, so the WAD can't be packed"
+#endif
+
+#ifndef NC_MMAP_FILE
+#define NC_MMAP_FILE "gbadoom1.wad"
+#endif
+
+static const uint8_t *wad = nullptr;
+static size_t wadsize = 0;
+static const filelump_t *directory = nullptr;
+static int numlumps = 0;
+
+/**
+ * Return a pointer to the lump in the mapping, or one of the objects mapped permanently
+ */
+static const uint8_t * LumpPtr(int lumpnum)
+{
+    if (lumpnum == STBAR_LUMP_NUM) return (const uint8_t *)gfx_stbar;
+    if (lumpnum == JUNK_LUMP_NUM) return (const uint8_t *)&junk;
+    if (lumpnum < 0 || lumpnum >= numlumps) return nullptr;
+    return wad + directory[lumpnum].filepos;
+}
+
+const uint8_t * NC_CacheLumpNum(int lumpnum)
+{
+    return LumpPtr(lumpnum);
+}
+
+int NC_LumpLength(int lumpnum)
+{
+    if (lumpnum < 0 || lumpnum >= numlumps) return 0;
+    return directory[lumpnum].size;
+}
+
+int NC_GetNumForName (const char* name)
+{
+    return NC_CheckNumForName(name);
+}
+
+int NC_CheckNumForName(const char *name)
+{
+    return LC_CheckNumForName(name);
+}
+
+const char* NC_GetNameForNum(int lump, char buffer[8])
+{
+    memcpy(buffer,directory[lump].name,8);
+    return buffer;
+}
+
+/**
+ * Map the WAD file and find the lump directory in it
+ */
+void NC_Init(void)
+{
+    int fd = open(NC_MMAP_FILE,O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd,&st) != 0) {
+        printf("Couldn't open WAD file %s\n",NC_MMAP_FILE);
+        assert(false);exit(-1);
+    }
+    wadsize = st.st_size;
+    void *map = mmap(nullptr,wadsize,PROT_READ,MAP_PRIVATE,fd,0);
+    close(fd); // The mapping stays valid
+    if (map == MAP_FAILED) {
+        printf("Couldn't map WAD file %s\n",NC_MMAP_FILE);
+        assert(false);exit(-1);
+    }
+    wad = (const uint8_t *)map;
+    const wadinfo_t *header = (const wadinfo_t *)wad;
+    if (strncmp(header->identification,"IWAD",4) && strncmp(header->identification,"PWAD",4)) {
+        printf("%s is not a WAD file\n",NC_MMAP_FILE);
+        assert(false);exit(-1);
+    }
+    directory = (const filelump_t *)(wad + header->infotableofs);
+    numlumps = header->numlumps;
+    LC_Init();
+    for (int i=-1; i<MAXLUMPS; i++)
+        nc_epochptrs[i+1] = LumpPtr(i);
+}
+
+void NC_ExtractFileBase(const char* path, char* dest)
+{
+    // BDP: Lifted directly from w_wad
+    const char *src = path + strlen(path) - 1;
+    int length;
+
+    // back up until a \ or the start
+    while (src != path && src[-1] != ':' // killough 3/22/98: allow c:filename
+           && *(src-1) != '\\'
+           && *(src-1) != '/')
+    {
+        src--;
+    }
+
+    // copy up to eight characters
+    memset(dest,0,8);
+    length = 0;
+
+    while ((*src) && (*src != '.') && (++length<9))
+    {
+        *dest++ = toupper(*src);
+        src++;
+    }
+}
+
+const uint8_t* NC_Pin(int lumpnum)
+{
+    // The mapping never moves
+    return LumpPtr(lumpnum);
+}
+
+const uint8_t* NC_PinRange(int lumpnum, int offset, int len UNUSED)
+{
+    return LumpPtr(lumpnum)+offset;
+}
+
+void NC_Unpin(int lumpnum UNUSED)
+{
+}
+
+void NC_FlushCache(void)
+{
+    // Nothing is cached - the page cache of the OS does the job
+}
+
+void NC_EndLevel(void)
+{
+}
+
+void NC_Prefetch(int lumpnum)
+{
+    // Let the OS start reading the pages in
+    if (lumpnum < 0 || lumpnum >= numlumps) return;
+    uintptr_t start = (uintptr_t)(wad + directory[lumpnum].filepos);
+    uintptr_t pagestart = start & ~(uintptr_t)(sysconf(_SC_PAGESIZE)-1);
+    madvise((void *)pagestart,start-pagestart+directory[lumpnum].size,MADV_WILLNEED);
+}
+
+void NC_ServicePrefetch(void)
+{
+}
+
+void NC_BeginLevel(int maplump UNUSED)
+{
+}
+
+void NC_LevelTic(void)
+{
+}
+
+const nc_stats_t* NC_GetStats(void)
+{
+    // Nothing is counted in this implementation
+    static nc_stats_t stats;
+    return &stats;
+}
+
+int NC_GetLumpMisses(int lumpnum UNUSED)
+{
+    return 0;
+}
+
+void NC_EndFrame(void)
+{
+}
+
+bool NC_GetFrameStats(int age UNUSED, nc_stats_t *stats UNUSED)
+{
+    return false;
+}
+
+void NC_DescribeBlock(uint8_t *ptr UNUSED, struct th_blockinfo_s *info UNUSED)
+{
+    // Lumps are in the mapping, not the tagheap
+}
+
+void NC_IdleDefrag(void)
+{
+}
+
+// Always in an epoch, as lumps stay where they are for good
+const uint8_t *nc_epochptrs[MAXLUMPS+1];
+
+void NC_BeginEpoch(void)
+{
+}
+
+void NC_EndEpoch(void)
+{
+}
+
+const uint8_t* NC_EpochPtr(int lumpnum)
+{
+    return LumpPtr(lumpnum);
+}
+
+const uint8_t* NC_EpochCacheLumpNum(int lumpnum)
+{
+    return LumpPtr(lumpnum);
+}
+
+const uint8_t* NC_EpochPin(int lumpnum, bool *pinned)
+{
+    *pinned = false;
+    return LumpPtr(lumpnum);
+}
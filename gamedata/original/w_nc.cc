@@ -64,6 +64,10 @@ const uint8_t* NC_Pin(int lumpnum)
 {
     return NC_CacheLumpNum(lumpnum); // We can assume it is constant in this implementaiton
 }
+const uint8_t* NC_PinRange(int lumpnum, int offset, int len UNUSED)
+{
+    return NC_CacheLumpNum(lumpnum)+offset;
+}
 void NC_Unpin(int lumpnum UNUSED)
 {
     // No-op for this simple cache
@@ -72,4 +76,87 @@ void NC_Unpin(int lumpnum UNUSED)
 void NC_FlushCache(void)
 {
     // No-op for this simple cache
-}
\ No newline at end of file
+}
+
+void NC_EndLevel(void)
+{
+    // No-op for this simple cache
+}
+
+void NC_Prefetch(int lumpnum UNUSED)
+{
+    // No-op for this simple cache
+}
+
+void NC_BeginLevel(int maplump UNUSED)
+{
+    // No-op for this simple cache
+}
+
+void NC_LevelTic(void)
+{
+    // No-op for this simple cache
+}
+
+const nc_stats_t* NC_GetStats(void)
+{
+    // Nothing is counted in this implementation
+    static nc_stats_t stats;
+    return &stats;
+}
+
+int NC_GetLumpMisses(int)
+{
+    return 0;
+}
+
+void NC_EndFrame(void)
+{
+}
+
+bool NC_GetFrameStats(int, nc_stats_t *)
+{
+    return false;
+}
+
+void NC_DescribeBlock(uint8_t *, struct th_blockinfo_s *)
+{
+    // Lumps aren't kept in the tagheap
+}
+
+void NC_ServicePrefetch(void)
+{
+    // No-op for this simple cache
+}
+
+void NC_IdleDefrag(void)
+{
+    // No-op for this simple cache
+}
+
+// Epochs are not supported - proxies always take the normal path
+const uint8_t *nc_epochptrs[MAXLUMPS+1];
+
+void NC_BeginEpoch(void)
+{
+}
+
+void NC_EndEpoch(void)
+{
+}
+
+const uint8_t* NC_EpochPtr(int)
+{
+    return nullptr;
+}
+
+const uint8_t* NC_EpochCacheLumpNum(int lumpnum)
+{
+    return NC_CacheLumpNum(lumpnum);
+}
+
+const uint8_t* NC_EpochPin(int lumpnum, bool *pinned)
+{
+    *pinned = true;
+    return NC_Pin(lumpnum);
+}
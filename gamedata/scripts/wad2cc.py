@@ -2,20 +2,177 @@ import sys
 import struct
 import os
 
+# Lump names are hashed with a minimal perfect hash (hash and displace): a first hash
+# picks a bucket, and the bucket's seed makes a second hash that maps every name in
+# the bucket to its own slot. LumpNameHash() in the generated header must match
+# name_hash() below.
+HASH_BUCKET_LOAD = 4
+
+def mix32(x):
+    return x & 0xffffffff
+
+def name_hash(name_low, name_high, seed):
+    h = mix32((name_low ^ seed) * 0x9e3779b1)
+    h ^= h >> 15
+    h ^= name_high
+    h = mix32(h * 0x85ebca77)
+    h ^= h >> 13
+    return h
+
+# Maps a hash onto 0..n-1 with a multiply instead of a division
+def reduce(h, n):
+    return (h * n) >> 32
+
+def build_name_hash(lumps):
+    # Index the first lump with a given name, which is what a linear search finds
+    keys = {}
+    for i, lump in enumerate(lumps):
+        keys.setdefault((lump.name_low, lump.name_high), i)
+    nslots = len(keys)
+    nbuckets = (nslots + HASH_BUCKET_LOAD - 1) // HASH_BUCKET_LOAD
+    buckets = [[] for _ in range(nbuckets)]
+    for key in keys:
+        buckets[reduce(name_hash(key[0], key[1], 0), nbuckets)].append(key)
+    seeds = [0] * nbuckets
+    index = [-1] * nslots
+    # Place the largest buckets first while there is still plenty of room
+    for b in sorted(range(nbuckets), key=lambda b: -len(buckets[b])):
+        if not buckets[b]:
+            continue
+        seed = 1
+        while True:
+            slots = [reduce(name_hash(k[0], k[1], seed), nslots) for k in buckets[b]]
+            if len(set(slots)) == len(slots) and all(index[s] == -1 for s in slots):
+                break
+            seed += 1
+        seeds[b] = seed
+        for k, s in zip(buckets[b], slots):
+            index[s] = keys[k]
+    return seeds, index
+
+# Packed lumps use the LZ4 block format. A lump is only stored packed when it shrinks by
+# at least 1/PACK_MIN_SAVING, as every packed lump costs a decompression on each miss.
+PACK_MIN_SAVING = 8
+LZ4_MINMATCH = 4
+LZ4_MAXOFFSET = 65535
+
+def lz4_pack(data):
+    """Greedy LZ4 block compression. Returns the packed bytes and the sequences as
+    (literals, matchlength) pairs, which the in-place margin is computed from."""
+    out = bytearray()
+    seqs = []
+    table = {}
+    n = len(data)
+    # The format wants the last match to start 12 bytes before the end and 5 literals last
+    limit = n - 12
+    anchor = 0
+    i = 0
+    while i < limit:
+        key = data[i:i+4]
+        cand = table.get(key)
+        table[key] = i
+        if cand is None or i - cand > LZ4_MAXOFFSET:
+            i += 1
+            continue
+        mlen = 4
+        while i + mlen < n - 5 and data[cand+mlen] == data[i+mlen]:
+            mlen += 1
+        lit = i - anchor
+        lz4_sequence(out, data[anchor:i], i - cand, mlen)
+        seqs.append((lit, mlen))
+        i += mlen
+        anchor = i
+    lz4_sequence(out, data[anchor:], 0, 0)
+    seqs.append((n - anchor, 0))
+    return bytes(out), seqs
+
+def lz4_length(out, length):
+    length -= 15
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+
+def lz4_sequence(out, literals, offset, mlen):
+    lit = len(literals)
+    ml = mlen - LZ4_MINMATCH if mlen else 0
+    out.append((min(lit, 15) << 4) | min(ml, 15))
+    if lit >= 15:
+        lz4_length(out, lit)
+    out += literals
+    if mlen:
+        out += struct.pack('<H', offset)
+        if ml >= 15:
+            lz4_length(out, ml)
+
+def lz4_margin(seqs, size, packed):
+    """Extra bytes needed after the lump to decompress it in place, with the packed bytes
+    read into the end of the block. No byte may be written before it has been read."""
+    def ext(length):
+        return (length - 15) // 255 + 1 if length >= 15 else 0
+    w = r = 0
+    worst = 0
+    for lit, mlen in seqs:
+        r += 1 + ext(lit) + lit
+        w += lit
+        worst = max(worst, w - r)
+        if mlen:
+            r += 2 + ext(mlen - LZ4_MINMATCH)
+            w += mlen
+            worst = max(worst, w - r)
+    # The byte written at w-1 overwrites input byte w-1-(size+margin-packed), which must be < r
+    return max(0, worst + packed - size)
+
 class FileLump:
     def __init__(self, filepos, size, name_high, name_low):
         self.filepos = filepos
         self.size = size
         self.name_high = name_high
         self.name_low = name_low
+        self.packedsize = 0
+
+def pack_wad(wadfile, lumps, packedfile):
+    """Write a copy of the WAD with packed lumps. The directory follows the header and holds
+    the sizes in the file, the lump tables hold the unpacked size and the packed size (0 for
+    lumps stored as they are). Returns the margin that packed lumps need."""
+    with open(wadfile, "rb") as f:
+        wad = f.read()
+    margin = 0
+    datapos = 12 + 16*len(lumps)
+    blobs = []
+    for lump in lumps:
+        data = wad[lump.filepos:lump.filepos+lump.size]
+        if lump.size:
+            packed, seqs = lz4_pack(data)
+            if len(packed) <= lump.size - lump.size // PACK_MIN_SAVING:
+                margin = max(margin, lz4_margin(seqs, lump.size, len(packed)))
+                lump.packedsize = len(packed)
+                data = packed
+        lump.filepos = datapos
+        datapos += len(data)
+        blobs.append(data)
+    with open(packedfile, "wb") as f:
+        f.write(struct.pack('<4sii', wad[0:4], len(lumps), 12))
+        for lump, data in zip(lumps, blobs):
+            f.write(struct.pack('<iiII', lump.filepos, len(data), lump.name_low, lump.name_high))
+        for data in blobs:
+            f.write(data)
+    return (margin + 3) & ~3
 
 def main():
-    if len(sys.argv) != 2:
-        print("Usage: python wad2cc.py <wadfile>")
+    args = sys.argv[1:]
+    pack = args[:1] == ["--pack"]
+    if pack:
+        args = args[1:]
+    if len(args) != 1:
+        print("Usage: python wad2cc.py [--pack] <wadfile>")
+        print("  --pack writes <base>z.wad with LZ4 packed lumps and tables for it")
         sys.exit(1)
 
-    wadfile = sys.argv[1]
+    wadfile = args[0]
     base = os.path.splitext(os.path.basename(wadfile))[0]
+    if pack:
+        base += "z"
     ccfile = f"{base}_lumps.cc"
     hfile = f"{base}_lumps.h"
     guard = f"_{base.upper()}_LUMPS_H_"
@@ -36,38 +193,98 @@ def main():
             filepos, size, name_low, name_high = struct.unpack('<iiII', lumpdata)
             lumps.append(FileLump(filepos, size, name_high, name_low))
 
+    if pack:
+        margin = pack_wad(wadfile, lumps, f"{base}.wad")
+
+    seeds, index = build_name_hash(lumps)
+
     # Write header
     with open(hfile, "w") as h:
         h.write(f"#ifndef {guard}\n")
         h.write(f"#define {guard}\n\n")
-        h.write(f"#include <stdint.h>\n\n")
-        h.write(f"#define WADLUMPS {numlumps}\n\n")
-        h.write(f"extern int32_t filepos[WADLUMPS];\n")
-        h.write(f"extern int32_t lumpsize[WADLUMPS];\n")
-        h.write(f"extern uint32_t lumpname_high[WADLUMPS];\n")
-        h.write(f"extern uint32_t lumpname_low[WADLUMPS];\n\n")
+        h.write(f"#include <stdint.h>\n")
+        h.write(f'#include "annotations.h"\n\n')
+        h.write(f"#define WADLUMPS {numlumps}\n")
+        h.write(f"#define LUMPHASH_BUCKETS {len(seeds)}\n")
+        h.write(f"#define LUMPHASH_SLOTS {len(index)}\n\n")
+        h.write(f"\n")
+        h.write(f"extern ConstMemArray<int32_t> filepos;\n")
+        h.write(f"extern ConstMemArray<int32_t> lumpsize;\n")
+        h.write(f"extern ConstMemArray<uint32_t> lumpname_high;\n")
+        h.write(f"extern ConstMemArray<uint32_t> lumpname_low;\n\n")
+        if pack:
+            h.write(f"// Lumps with a packed size are LZ4 packed, and need WADPACK_MARGIN bytes more than\n")
+            h.write(f"// their size to be decompressed in place\n")
+            h.write(f"#define WADPACK_MARGIN {margin}\n")
+            h.write(f"extern ConstMemArray<int32_t> packedsize;\n\n")
+        h.write(f"// Minimal perfect hash of the lump names, see LumpNameIndex() for how to look up a name\n")
+        h.write(f"extern ConstMemArray<uint32_t> lumphash_seed;\n")
+        h.write(f"extern ConstMemArray<int32_t> lumphash_index;\n\n")
+        h.write(f"static inline uint32_t LumpNameHash(uint32_t name_low, uint32_t name_high, uint32_t seed)\n")
+        h.write(f"{{\n")
+        h.write(f"    uint32_t h = (name_low ^ seed) * 0x9e3779b1u;\n")
+        h.write(f"    h ^= h >> 15;\n")
+        h.write(f"    h ^= name_high;\n")
+        h.write(f"    h *= 0x85ebca77u;\n")
+        h.write(f"    h ^= h >> 13;\n")
+        h.write(f"    return h;\n")
+        h.write(f"}}\n\n")
+        h.write(f"// Maps a hash onto 0..n-1 with a multiply instead of a division\n")
+        h.write(f"static inline uint32_t LumpHashReduce(uint32_t h, uint32_t n)\n")
+        h.write(f"{{\n")
+        h.write(f"    return ((uint64_t)h * n) >> 32;\n")
+        h.write(f"}}\n\n")
+        h.write(f"// The only lump that can have the given name. Names that aren't in the WAD map to\n")
+        h.write(f"// some lump too, so the caller must compare the name.\n")
+        h.write(f"static inline int LumpNameIndex(uint32_t name_low, uint32_t name_high)\n")
+        h.write(f"{{\n")
+        h.write(f"    uint32_t seed = lumphash_seed[LumpHashReduce(LumpNameHash(name_low, name_high, 0), LUMPHASH_BUCKETS)];\n")
+        h.write(f"    return lumphash_index[LumpHashReduce(LumpNameHash(name_low, name_high, seed), LUMPHASH_SLOTS)];\n")
+        h.write(f"}}\n\n")
         h.write(f"#endif // {guard}\n")
 
     # Write .cc file
     with open(ccfile, "w") as cc:
         cc.write(f'#include "{hfile}"\n')
         cc.write('#include "annotations.h"\n\n')
-        cc.write(f"int32_t CONSTMEM filepos[WADLUMPS] = {{\n")
+        cc.write(f"int32_t CONSTMEM _filepos[WADLUMPS] = {{\n")
         for lump in lumps:
             cc.write(f"    {lump.filepos},\n")
         cc.write("};\n\n")
-        cc.write(f"int32_t CONSTMEM lumpsize[WADLUMPS] = {{\n")
+        cc.write(f"int32_t CONSTMEM _lumpsize[WADLUMPS] = {{\n")
         for lump in lumps:
             cc.write(f"    {lump.size},\n")
         cc.write("};\n\n")
-        cc.write(f"uint32_t CONSTMEM lumpname_high[WADLUMPS] = {{\n")
+        cc.write(f"uint32_t CONSTMEM _lumpname_high[WADLUMPS] = {{\n")
         for lump in lumps:
             cc.write(f"    0x{lump.name_high:08x},\n")
         cc.write("};\n\n")
-        cc.write(f"uint32_t CONSTMEM lumpname_low[WADLUMPS] = {{\n")
+        cc.write(f"uint32_t CONSTMEM _lumpname_low[WADLUMPS] = {{\n")
         for lump in lumps:
             cc.write(f"    0x{lump.name_low:08x},\n")
-        cc.write("};\n")
+        cc.write("};\n\n")
+        if pack:
+            cc.write(f"int32_t CONSTMEM _packedsize[WADLUMPS] = {{\n")
+            for lump in lumps:
+                cc.write(f"    {lump.packedsize},\n")
+            cc.write("};\n\n")
+        cc.write(f"uint32_t CONSTMEM _lumphash_seed[LUMPHASH_BUCKETS] = {{\n")
+        for seed in seeds:
+            cc.write(f"    {seed},\n")
+        cc.write("};\n\n")
+        cc.write(f"int32_t CONSTMEM _lumphash_index[LUMPHASH_SLOTS] = {{\n")
+        for i in index:
+            cc.write(f"    {i},\n")
+        cc.write("};\n\n")
+        cc.write("// Array representations\n")
+        cc.write("ConstMemArray<int32_t> filepos(_filepos);\n")
+        cc.write("ConstMemArray<int32_t> lumpsize(_lumpsize);\n")
+        cc.write("ConstMemArray<uint32_t> lumpname_high(_lumpname_high);\n")
+        cc.write("ConstMemArray<uint32_t> lumpname_low(_lumpname_low);\n")
+        if pack:
+            cc.write("ConstMemArray<int32_t> packedsize(_packedsize);\n")
+        cc.write("ConstMemArray<uint32_t> lumphash_seed(_lumphash_seed);\n")
+        cc.write("ConstMemArray<int32_t> lumphash_index(_lumphash_index);\n")
 
 if __name__ == "__main__":
     main()
@@ -0,0 +1,113 @@
+/* Emacs style mode select   -*- C++ -*-
+ *-----------------------------------------------------------------------------
+ *
+ *
+ *  PrBoom: a Doom port merged with LxDoom and LSDLDoom
+ *  based on BOOM, a modified and improved DOOM engine
+ *  Copyright (C) 1999 by
+ *  id Software, Chi Hoang, Lee Killough, Jim Flynn, Rand Phares, Ty Halderman
+ *  Copyright (C) 1999-2000 by
+ *  Jess Haas, Nicolas Kalkhof, Colin Phipps, Florian Schulze
+ *  Copyright 2005, 2006 by
+ *  Florian Schulze, Colin Phipps, Neil Stevens, Andrey Budko
+ *  Copyright 2025 by
+ *  Brian Dam Pedersen
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License
+ *  as published by the Free Software Foundation; either version 2
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+ *  02111-1307, USA.
+ *
+ * DESCRIPTION:
+ *      Renderer profiler: time spent in each stage of a frame and what it
+ *      drew, kept for the last frames in a ring that ports can read back.
+ *
+ *-----------------------------------------------------------------------------*/
+
+#ifndef __R_PROFILE__
+#define __R_PROFILE__
+
+#include <stdint.h>
+
+// Set RENDER_PROFILE to 1 to time the stages of each frame and count the columns, spans,
+// visplanes, drawsegs and vissprites drawn. It needs a host clock, so not on the GBA.
+#ifndef RENDER_PROFILE
+#define RENDER_PROFILE 0
+#endif
+
+typedef enum {
+    RP_BSP,         // R_RenderBSPNode, less the seg loops
+    RP_SEGS,        // R_RenderSegLoop
+    RP_PLANES,      // R_DrawPlanes
+    RP_MASKED,      // R_DrawMasked, less the player sprites
+    RP_PSPRITES,    // R_DrawPlayerSprites
+    RP_STATUSBAR,   // ST_Drawer
+    RP_HUD,         // HU_Drawer
+    RP_BLIT,        // I_FinishUpdate
+    RP_OTHER,       // Everything else: game tics, menus, setup of the view
+    RP_PHASES
+} rp_phase_t;
+
+typedef struct {
+    uint32_t frame;
+    uint32_t ns[RP_PHASES];        // Time spent in each stage
+    uint32_t columns[RP_PHASES];   // Columns drawn by each stage
+    uint32_t spans[RP_PHASES];     // Spans drawn by each stage
+    uint32_t visplanes;            // Visplanes drawn
+    uint32_t drawsegs;             // Drawsegs at the end of the BSP traversal
+    uint32_t vissprites;           // Vissprites at the end of the BSP traversal
+} rp_framestats_t;
+
+const char* RP_PhaseName(rp_phase_t phase);
+
+#if RENDER_PROFILE == 1
+
+#ifdef GBA
+#error "The renderer profiler needs a host clock"
+#endif
+
+// Stages nest - time spent in an inner stage is not counted in the outer one
+void RP_Begin(rp_phase_t phase);
+void RP_End(void);
+// Close the frame and store it in the ring. RP_GetFrameStats() reads it back, age 0 being
+// the last finished frame, and returns false if that frame isn't in the ring.
+void RP_EndFrame(void);
+bool RP_GetFrameStats(int age, rp_framestats_t *stats);
+
+// The frame being profiled and the stage it is in
+extern rp_framestats_t rp_frame;
+extern rp_phase_t rp_phase;
+
+struct rp_scope_t {
+    rp_scope_t(rp_phase_t phase) { RP_Begin(phase); }
+    ~rp_scope_t() { RP_End(); }
+};
+
+#define RP_BEGIN(phase) RP_Begin(phase)
+#define RP_END() RP_End()
+#define RP_SCOPE(phase) rp_scope_t rp_scope(phase) // The rest of the enclosing block
+#define RP_COLUMN() (rp_frame.columns[rp_phase]++)
+#define RP_SPAN() (rp_frame.spans[rp_phase]++)
+#define RP_COUNT(counter,n) (rp_frame.counter += (n))
+#define RP_ENDFRAME() RP_EndFrame()
+#else
+#define RP_BEGIN(phase)
+#define RP_END()
+#define RP_SCOPE(phase)
+#define RP_COLUMN()
+#define RP_SPAN()
+#define RP_COUNT(counter,n)
+#define RP_ENDFRAME()
+#endif
+
+#endif
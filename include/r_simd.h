@@ -0,0 +1,68 @@
+/* Emacs style mode select   -*- C++ -*-
+ *-----------------------------------------------------------------------------
+ *
+ *
+ *  PrBoom: a Doom port merged with LxDoom and LSDLDoom
+ *  based on BOOM, a modified and improved DOOM engine
+ *  Copyright (C) 1999 by
+ *  id Software, Chi Hoang, Lee Killough, Jim Flynn, Rand Phares, Ty Halderman
+ *  Copyright (C) 1999-2000 by
+ *  Jess Haas, Nicolas Kalkhof, Colin Phipps, Florian Schulze
+ *  Copyright 2005, 2006 by
+ *  Florian Schulze, Colin Phipps, Neil Stevens, Andrey Budko
+ *  Copyright 2025 by
+ *  Brian Dam Pedersen
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License
+ *  as published by the Free Software Foundation; either version 2
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+ *  02111-1307, USA.
+ *
+ * DESCRIPTION:
+ *      SIMD span and column drawers for hosts, picked at startup for the
+ *      CPU the game runs on.
+ *
+ *-----------------------------------------------------------------------------*/
+
+#ifndef __R_SIMD__
+#define __R_SIMD__
+
+#include <stdint.h>
+
+// Set RENDER_SIMD to 1 to draw spans and columns with SSE2 or AVX2 on x86 and NEON on ARM. The
+// drawers compute the texture positions of several pixels at once, and AVX2 also gathers the
+// texels and colours. Set the environment variable RENDER_SIMD to scalar, sse2, avx2 or neon
+// to pick one rather than the best the CPU has. Hosts only, as pixels are doubled to 16 bits.
+#ifndef RENDER_SIMD
+#define RENDER_SIMD 0
+#endif
+
+#if RENDER_SIMD == 1
+
+#ifdef GBA
+#error "The SIMD drawers are for hosts"
+#endif
+
+// Same arguments and pixels as the inner loops of R_DrawSpan() and R_DrawColumn()
+typedef void (*rs_drawspan_f)(unsigned short* dest, const uint8_t* source, const uint8_t* colormap, unsigned int position, unsigned int step, unsigned int count);
+typedef void (*rs_drawcolumn_f)(unsigned short* dest, const uint8_t* source, const uint8_t* colormap, unsigned int frac, unsigned int fracstep, int count);
+
+extern rs_drawspan_f RS_DrawSpan;
+extern rs_drawcolumn_f RS_DrawColumn;
+
+// Name of the drawers in use
+const char* RS_Name(void);
+
+#endif
+
+#endif
@@ -0,0 +1,59 @@
+/* Emacs style mode select   -*- C++ -*-
+ *-----------------------------------------------------------------------------
+ *
+ *
+ *  PrBoom: a Doom port merged with LxDoom and LSDLDoom
+ *  based on BOOM, a modified and improved DOOM engine
+ *  Copyright (C) 1999 by
+ *  id Software, Chi Hoang, Lee Killough, Jim Flynn, Rand Phares, Ty Halderman
+ *  Copyright (C) 1999-2000 by
+ *  Jess Haas, Nicolas Kalkhof, Colin Phipps, Florian Schulze
+ *  Copyright 2005, 2006 by
+ *  Florian Schulze, Colin Phipps, Neil Stevens, Andrey Budko
+ *  Copyright 2025 by
+ *  Brian Dam Pedersen
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License
+ *  as published by the Free Software Foundation; either version 2
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+ *  02111-1307, USA.
+ *
+ * DESCRIPTION:
+ *      Worker pool for drawing the view on several threads, each one
+ *      owning a strip of screen columns. Hosts only.
+ *
+ *-----------------------------------------------------------------------------*/
+
+#ifndef __R_THREADS__
+#define __R_THREADS__
+
+// Set RENDER_THREADS to the number of threads that draw the view, the calling one included.
+// The BSP traversal, planes and sprites are then walked as usual, but the columns and spans they
+// draw are queued and drawn by the pool in strips of screen columns. 0 draws them right away.
+#ifndef RENDER_THREADS
+#define RENDER_THREADS 0
+#endif
+
+#if RENDER_THREADS > 0
+
+#ifdef GBA
+#error "The render threads need a host with threads"
+#endif
+
+// Call job once for each strip [x1,x2) of screen columns, one strip per thread, and return
+// when all of them are done. The calling thread draws the first strip.
+void RT_Run(void (*job)(int x1, int x2));
+
+#endif
+
+#endif
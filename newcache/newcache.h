@@ -46,8 +46,80 @@ int NC_LumpLength(int lumpnum);
 void NC_Init(void);
 void NC_ExtractFileBase(const char* path, char* dest);
 const uint8_t* NC_Pin(int lumpnum);
+// Pin only part of a lump - large lumps are then loaded page by page as needed. Unpin as usual.
+const uint8_t* NC_PinRange(int lumpnum, int offset, int len);
 void NC_Unpin(int lumpnum);
 void NC_FlushCache(void);
+// Level transition: evict the lumps of the map and those that went cold, keep the rest
+void NC_EndLevel(void);
+// Asynchronous loading: queue a lump to be loaded ahead of use, and let the
+// loader make progress (or reap finished loads) at a convenient point in time
+void NC_Prefetch(int lumpnum);
+void NC_ServicePrefetch(void);
+// Compact the cache a little - call once per frame when there is time to spare
+void NC_IdleDefrag(void);
+// Epochs: between NC_BeginEpoch() and NC_EndEpoch() lumps accessed through the proxies below
+// are neither evicted nor moved, so they resolve to plain pointers after the first access
+void NC_BeginEpoch(void);
+void NC_EndEpoch(void);
+const uint8_t* NC_EpochPtr(int lumpnum);
+// The proxies' calls for lumps that aren't held yet - they try to hold them first
+const uint8_t* NC_EpochCacheLumpNum(int lumpnum);
+const uint8_t* NC_EpochPin(int lumpnum, bool *pinned);
+// Level warm-up: preload what the map needed last time, and record what it needs now.
+// NC_LevelTic() is called once per tic of play - NC_EndLevel() also measures coldness in these
+void NC_BeginLevel(int maplump);
+void NC_LevelTic(void);
+
+// Telemetry: counters are cumulative from NC_Init(). NC_EndFrame() closes a frame and
+// stores what happened during it in a small ring that ports can read back with
+// NC_GetFrameStats() (age 0 is the last finished frame).
+typedef struct {
+    uint32_t frame;
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t defrags;
+    uint32_t defragbytes;
+    uint32_t bytesread;
+    uint32_t flashus;       // WR_FlashTime() at the last NC_EndFrame(), per frame in the ring
+} nc_stats_t;
+
+const nc_stats_t* NC_GetStats(void);
+int NC_GetLumpMisses(int lumpnum);
+void NC_EndFrame(void);
+bool NC_GetFrameStats(int age, nc_stats_t *stats);
+// Heap map: callback for TH_snapshot() in minimem/tagheap.h that fills in the lump a block
+// holds and whether it is pinned. Caches that don't keep lumps in the tagheap leave it be.
+struct th_blockinfo_s;
+void NC_DescribeBlock(uint8_t *ptr, struct th_blockinfo_s *info);
+
+// Record of the access trace written by caches built with NC_ACCESSTRACE=1. There
+// is one record per API call, arg being the lump number (map lump for NC_TRACE_LEVEL).
+// NC_TRACE_PINRANGE is followed by an NC_TRACE_RANGE record holding the offset in 
+// 16 byte units in arg and the length in 16 byte units in aux.
+typedef struct {
+    uint8_t op;
+    uint8_t aux;
+    int16_t arg;
+} nc_tracerecord_t;
+
+#define NC_TRACE_CACHE 'C'     // NC_CacheLumpNum
+#define NC_TRACE_PIN 'P'       // NC_Pin
+#define NC_TRACE_UNPIN 'U'     // NC_Unpin
+#define NC_TRACE_PREFETCH 'H'  // NC_Prefetch
+#define NC_TRACE_SERVICE 'S'   // NC_ServicePrefetch
+#define NC_TRACE_FLUSH 'X'     // NC_FlushCache
+#define NC_TRACE_ENDLEVEL 'Q'  // NC_EndLevel
+#define NC_TRACE_LEVEL 'L'     // NC_BeginLevel
+#define NC_TRACE_TIC 'T'       // NC_LevelTic
+#define NC_TRACE_FRAME 'F'     // NC_EndFrame
+#define NC_TRACE_IDLEDEFRAG 'D' // NC_IdleDefrag
+#define NC_TRACE_BEGINEPOCH 'B' // NC_BeginEpoch
+#define NC_TRACE_ENDEPOCH 'E'   // NC_EndEpoch
+#define NC_TRACE_EPOCHPTR 'R'   // NC_EpochPtr
+#define NC_TRACE_PINRANGE 'G'   // NC_PinRange
+#define NC_TRACE_RANGE '+'      // Range of the NC_PinRange before it
 
 // WAD parser types
 typedef struct
@@ -71,6 +143,14 @@ typedef struct
 #define WADLUMPS 1158
 #define MAXLUMPS 1160
 
+// What the current epoch holds, by lumpnum+1 so that -1 can be looked up too. Null when the lump
+// isn't held. The static mappings are always held.
+extern const uint8_t *nc_epochptrs[MAXLUMPS+1];
+
+static inline const uint8_t *NC_EpochHeld(int lumpnum) {
+    return nc_epochptrs[lumpnum+1];
+}
+
 template <typename T>
 class Cached;
 
@@ -83,6 +163,7 @@ class Pinned {
     // TODO: implement pinning mechanism
         Pinned() : ptr(nullptr), lumpnum(-1) {}
         Pinned(short lumpnum, int _byteoffset) : ptr((T*)(NC_Pin(lumpnum) + _byteoffset)), lumpnum(lumpnum) {}
+        Pinned(short lumpnum, int _byteoffset, int len) : ptr((T*)NC_PinRange(lumpnum, _byteoffset, len)), lumpnum(lumpnum) {}
         ~Pinned() {NC_Unpin(lumpnum);}
 
         operator const T*() const {
@@ -160,7 +241,8 @@ class CachedBuffer {
 
     private:
         const char * base() const {
-            return (const char *)NC_CacheLumpNum(lumpnum);
+            const uint8_t *data = NC_EpochHeld(lumpnum);
+            return (const char *)(data ? data : NC_EpochCacheLumpNum(lumpnum));
         }
 
         short lumpnum;
@@ -171,9 +253,15 @@ template <typename T>
 class Sentinel {
     public:
     // TODO: implement pinning mechanism
-        Sentinel() : ptr(nullptr), lumpnum(-1) {}
-        Sentinel(short lumpnum, int _byteoffset) : ptr((T*)(NC_Pin(lumpnum)+_byteoffset)), lumpnum(lumpnum) {}
-        ~Sentinel() {NC_Unpin(lumpnum);}
+        Sentinel() : ptr(nullptr), lumpnum(-1), pinned(false) {}
+        Sentinel(short lumpnum, int _byteoffset) : lumpnum(lumpnum) {
+            // A lump the epoch holds stays put until the epoch ends - no need to pin it here
+            const uint8_t *data = NC_EpochHeld(lumpnum);
+            pinned = false;
+            if (!data) data = NC_EpochPin(lumpnum, &pinned);
+            ptr = (const T*)(data+_byteoffset);
+        }
+        ~Sentinel() {if (pinned) NC_Unpin(lumpnum);}
 
         const T* operator->() const {
             return ptr;
@@ -182,6 +270,7 @@ class Sentinel {
     private:
         const T* ptr;
         short lumpnum;
+        bool pinned;
 };
 
 template <typename T>
@@ -205,6 +294,11 @@ class Cached {
             return Pinned<T>(lumpnum, byteoffset);
         }
 
+        // Only the len bytes from here on can be used through the pin
+        const Pinned<T> pinRange(int len) const {
+            return Pinned<T>(lumpnum, byteoffset, len);
+        }
+
         template <typename U>
         Cached<U> transmuteToObjectAtByteOffset(int extrabyteoffset) const  {
             return Cached<U>(lumpnum, byteoffset+extrabyteoffset);
@@ -224,8 +318,8 @@ class Cached {
         }
     private:
         const char * base() const {
-            // TODO: Address this by pemanently pinning an entry in the cache for this
-            return (const char *)NC_CacheLumpNum(lumpnum);
+            const uint8_t *data = NC_EpochHeld(lumpnum);
+            return (const char *)(data ? data : NC_EpochCacheLumpNum(lumpnum));
         }
         short lumpnum;
         unsigned int byteoffset;
@@ -16,6 +16,11 @@
 
 #include "annotations.h"
 
+#include "wadreader.h"
+
+#include "r_profile.h"
+#include "r_simd.h"
+
 #ifndef __chess__
 #include <time.h>
 #endif
@@ -47,7 +52,8 @@ int I_GetTime(void)
     int thistimereply;
 
     #ifndef __chess__
-    clock_t now = clock();
+    // Time spent in (emulated) flash reads counts as if it had passed on the device
+    clock_t now = clock() + (clock_t)((uint64_t)WR_FlashTime() * CLOCKS_PER_SEC / 1000000);
 
     // For microseconds we can do (37*time_us)>>20
     thistimereply = (int)((double)now / ((double)CLOCKS_PER_SEC / (double)TICRATE));
@@ -140,12 +146,195 @@ void I_CreateBackBuffer_e32()
 
 //**************************************************************************************
 
+#ifndef __chess__
+// Wall clock time in microseconds from a clock that never steps, unlike clock() which is CPU time
+static uint64_t I_MonotonicUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+#endif
+
+// Append the cache activity of the last finished frame to ncstats.csv
+static void I_DumpCacheStats()
+{
+    static FILE *csv = NULL;
+    if (!csv)
+    {
+        csv = fopen("ncstats.csv", "w");
+        if (!csv)
+            return;
+        fprintf(csv, "frame,hits,misses,evictions,defrags,defragbytes,bytesread,flash_us\n");
+    }
+    // The cache closes its frames after the blit, so this is the frame before the one on
+    // screen. Its flash time is taken in NC_EndFrame() to match the other counters.
+    nc_stats_t s;
+    if (NC_GetFrameStats(0, &s))
+        fprintf(csv, "%u,%u,%u,%u,%u,%u,%u,%u\n", s.frame, s.hits, s.misses, s.evictions, s.defrags, s.defragbytes, s.bytesread, s.flashus);
+}
+
+#if RENDER_PROFILE == 1
+// Append the time and drawing of each renderer stage in the last finished frame to rprofile.csv
+static void I_DumpRenderProfile()
+{
+    static FILE *csv = NULL;
+    if (!csv)
+    {
+        csv = fopen("rprofile.csv", "w");
+        if (!csv)
+            return;
+        fprintf(csv, "frame");
+        for (int i = 0; i < RP_PHASES; i++)
+            fprintf(csv, ",%s_us,%s_columns,%s_spans", RP_PhaseName((rp_phase_t)i), RP_PhaseName((rp_phase_t)i), RP_PhaseName((rp_phase_t)i));
+        fprintf(csv, ",visplanes,drawsegs,vissprites\n");
+    }
+    rp_framestats_t s;
+    if (!RP_GetFrameStats(0, &s))
+        return;
+    fprintf(csv, "%u", s.frame);
+    for (int i = 0; i < RP_PHASES; i++)
+        fprintf(csv, ",%.1f,%u,%u", s.ns[i] / 1000.0, s.columns[i], s.spans[i]);
+    fprintf(csv, ",%u,%u,%u\n", s.visplanes, s.drawsegs, s.vissprites);
+}
+#endif
+
+// Write the lumps that missed in the cache, and how often, to nclumps.csv
+static void I_DumpLumpMisses()
+{
+    FILE *csv = fopen("nclumps.csv", "w");
+    if (!csv)
+        return;
+    fprintf(csv, "lump,name,misses\n");
+    for (int i = 0; i < WADLUMPS; i++)
+    {
+        int misses = NC_GetLumpMisses(i);
+        if (misses)
+        {
+            char name[9] = {0};
+            NC_GetNameForNum(i, name);
+            fprintf(csv, "%d,%s,%d\n", i, name, misses);
+        }
+    }
+    fclose(csv);
+}
+
+#ifndef HEAPMAP_FRAMES
+#define HEAPMAP_FRAMES 0 // Set to N to append a map of the heap to heapmap.bin every N frames
+#endif
+
+#if HEAPMAP_FRAMES > 0
+#include "tagheap.h"
+
+// Append a snapshot of every tagheap block to heapmap.bin, for ports/heapmap.py. Each
+// snapshot is a header followed by header.blocks th_blockinfo_t records.
+static void I_DumpHeapMap(int frame)
+{
+    static FILE *bin = NULL;
+    static th_blockinfo_t blocks[4096];
+    if (frame % HEAPMAP_FRAMES)
+        return;
+    if (!bin)
+    {
+        bin = fopen("heapmap.bin", "wb");
+        if (!bin)
+            return;
+    }
+    struct {
+        uint32_t frame;
+        uint32_t blocks;
+        uint32_t cacheheapsize;
+        uint32_t objectheapsize;
+    } header;
+    int count = TH_snapshot(blocks, 4096, NC_DescribeBlock);
+    header.frame = frame;
+    header.blocks = count < 4096 ? count : 4096;
+    header.cacheheapsize = TH_CACHEHEAPSIZE;
+    header.objectheapsize = TH_OBJECTHEAPSIZE;
+    fwrite(&header, sizeof(header), 1, bin);
+    fwrite(blocks, sizeof(blocks[0]), header.blocks, bin);
+    fflush(bin);
+}
+#endif
+
+#ifndef TIMEDEMO
+#define TIMEDEMO 0 // Set to 1 to time the demos (see d_main.cc) instead of dumping frames
+#endif
+
+#if TIMEDEMO == 1
+#include <algorithm>
+#include <vector>
+
+static std::vector<uint32_t> frametimes; // Microseconds from the frame before
+static uint64_t firstframe = 0;
+static uint64_t lastframe = 0;
+
+// Frame time in ms that p percent of the frames are within
+static double I_FramePercentile(const std::vector<uint32_t> &sorted, unsigned p)
+{
+    if (sorted.empty())
+        return 0.0;
+    size_t rank = (sorted.size() * p + 99) / 100;
+    return sorted[rank ? rank - 1 : 0] / 1000.0;
+}
+
+// Report the timing to stdout and timedemo.json when the game quits after the last demo
+static void I_WriteTimeDemo()
+{
+    std::vector<uint32_t> sorted(frametimes);
+    std::sort(sorted.begin(), sorted.end());
+    double seconds = (lastframe - firstframe) / 1000000.0;
+#if RENDER_SIMD == 1
+    const char *drawers = RS_Name();
+#else
+    const char *drawers = "default";
+#endif
+    char json[512];
+    snprintf(json, sizeof(json),
+        "{\"tics\": %d, \"frames\": %u, \"seconds\": %.3f, \"fps\": %.2f, "
+        "\"frame_ms\": {\"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f}, \"drawers\": \"%s\"}\n",
+        _g->gametic, (unsigned)sorted.size(), seconds, seconds > 0 ? sorted.size() / seconds : 0.0,
+        I_FramePercentile(sorted, 50), I_FramePercentile(sorted, 95), I_FramePercentile(sorted, 99),
+        I_FramePercentile(sorted, 100), drawers);
+    fputs(json, stdout);
+    FILE *f = fopen("timedemo.json", "w");
+    if (f)
+    {
+        fputs(json, f);
+        fclose(f);
+    }
+}
+
+// Time the frame that was just finished - nothing else is done per frame
+static void I_TimeFrame()
+{
+    uint64_t now = I_MonotonicUs();
+    if (!firstframe)
+    {
+        firstframe = now;
+        atexit(I_WriteTimeDemo);
+    }
+    else
+    {
+        frametimes.push_back((uint32_t)(now - lastframe));
+    }
+    lastframe = now;
+}
+#endif
+
+//**************************************************************************************
+
 void I_FinishUpdate_e32(const uint8_t* srcBuffer, const uint8_t* pallete, const unsigned int width UNUSED, const unsigned int height UNUSED)
 {
     // BDPNOTE: This is where the screenbuffer is drawn
     pb = (unsigned char*)srcBuffer;
     pl = (unsigned char*)pallete;
 
+    #if TIMEDEMO == 1
+    I_TimeFrame();
+    return;
+    #endif
+
     static int filenum = 0;
     static uint32_t timebase = 0xffffffff;
     char filename[256];
@@ -163,8 +352,7 @@ void I_FinishUpdate_e32(const uint8_t* srcBuffer, const uint8_t* pallete, const
         } palette[256] __attribute__((packed));
     } header;
     #ifndef __chess__
-    clock_t clock_now = clock();
-    uint32_t time_ms = (uint32_t)((double)clock_now / ((double)CLOCKS_PER_SEC / 1000.0));
+    uint32_t time_ms = (uint32_t)(I_MonotonicUs() / 1000);
     #else
     uint32_t clock_now = chess_cycle_count() >> 5;
     uint32_t time_ms = clock_now/1000;
@@ -180,10 +368,16 @@ void I_FinishUpdate_e32(const uint8_t* srcBuffer, const uint8_t* pallete, const
     lastcyclecount = cyclecount;
     #else
     static uint32_t lastclock = 0xffffffff;
+    static uint32_t lastflash = 0;
+    uint32_t flash_us = WR_FlashTime();
     if (lastclock != 0xffffffff) {
-        printf("Generated frame #%d in %u ms\n",filenum,time_ms-lastclock);
+        if (flash_us)
+            printf("Generated frame #%d in %u ms + %u us simulated flash stall\n",filenum,time_ms-lastclock,flash_us-lastflash);
+        else
+            printf("Generated frame #%d in %u ms\n",filenum,time_ms-lastclock);
     }
     lastclock = time_ms;
+    lastflash = flash_us;
     #endif
     
     FILE *f = fopen(filename, "wb");
@@ -206,9 +400,18 @@ void I_FinishUpdate_e32(const uint8_t* srcBuffer, const uint8_t* pallete, const
         printf("Failed to open screenbuffer dump file %s\n", filename);
     }
 
+    I_DumpCacheStats();
+    #if RENDER_PROFILE == 1
+    I_DumpRenderProfile();
+    #endif
+    #if HEAPMAP_FRAMES > 0
+    I_DumpHeapMap(filenum);
+    #endif
+
     // Stop after ~10 seconds
     if (filenum == 350) {
         printf("\n\n.. It did run DOOM\n");
+        I_DumpLumpMisses();
         exit(0);
     }
 }
@@ -281,7 +484,7 @@ void I_Error (const char *error, ...)
 
 void I_Quit_e32()
 {
-
+    I_DumpLumpMisses();
 }
 
 //**************************************************************************************
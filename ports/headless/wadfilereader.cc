@@ -4,11 +4,82 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#ifndef __chess__
+#include <time.h>
+#endif
 
 FILE *wad;
 
+/**
+ * Flash emulation for host builds. Each transaction costs WR_FLASH_LATENCY_NS, and whole
+ * WR_FLASH_PAGE byte pages are transferred at WR_FLASH_NS_PER_BYTE. The device keeps reading
+ * WR_FLASH_READAHEAD bytes past a transaction into a buffer, and reads served from that 
+ * buffer are free. The defaults match the timing emulated on __chess__ builds: 100 cycles
+ * of overhead and 5 cycles per byte at 16 MHz.
+ *
+ * WR_FLASH_EMULATION 0: off, 1: account the time on a virtual clock, 2: also sleep for it.
+ * The time is reported by WR_FlashTime() and added to the game clock by I_GetTime().
+ */
+#ifndef WR_FLASH_EMULATION
+#define WR_FLASH_EMULATION 0
+#endif
+
+#ifndef WR_FLASH_LATENCY_NS
+#define WR_FLASH_LATENCY_NS 6250
+#endif
+
+#ifndef WR_FLASH_NS_PER_BYTE
+#define WR_FLASH_NS_PER_BYTE 312
+#endif
+
+// Must be a power of two
+#ifndef WR_FLASH_PAGE
+#define WR_FLASH_PAGE 1
+#endif
+
+#ifndef WR_FLASH_READAHEAD
+#define WR_FLASH_READAHEAD 0
+#endif
+
+#if WR_FLASH_EMULATION != 0 && !defined(__chess__)
+static uint64_t flashtime_ns = 0;
+static int bufstart = 0;    // Contents of the read-ahead buffer
+static int bufend = 0;
+
+// Charge a transaction reading [offset,offset+len)
+static void FlashTransaction(int offset, int len) {
+    int end = offset+len;
+    // Whatever the read-ahead buffer holds doesn't need the device
+    if (offset >= bufstart && offset < bufend) {
+        if (end <= bufend) return;
+        offset = bufend;
+    }
+    int from = offset & ~(WR_FLASH_PAGE-1);
+    int to = ((end+WR_FLASH_PAGE-1) & ~(WR_FLASH_PAGE-1)) + WR_FLASH_READAHEAD;
+    uint64_t ns = WR_FLASH_LATENCY_NS + (uint64_t)(to-from)*WR_FLASH_NS_PER_BYTE;
+    flashtime_ns += ns;
+    bufstart = to-WR_FLASH_READAHEAD;
+    bufend = to;
+    #if WR_FLASH_EMULATION == 2
+    struct timespec wait = {(time_t)(ns/1000000000), (long)(ns%1000000000)};
+    nanosleep(&wait, NULL);
+    #endif
+}
+#define FLASH_TRANSACTION(offset,len) FlashTransaction(offset,len)
+#else
+#define FLASH_TRANSACTION(offset,len)
+#endif
+
+uint32_t WR_FlashTime() {
+    #if WR_FLASH_EMULATION != 0 && !defined(__chess__)
+    return (uint32_t)(flashtime_ns/1000);
+    #else
+    return 0;
+    #endif
+}
+
 void WR_Init(){
-    wad = fopen("gbadoom1.wad","rb");
+    wad = fopen(WR_WADFILE,"rb");
     if (!wad) {
         printf("Couldn't open WAD file\n");
         assert(false);exit(-1);
@@ -24,9 +95,45 @@ void WR_Read(uint8_t *dst, int offset, int len) {
     uint32_t readtime = 5*len+100;
     uint32_t t0 = chess_cycle_count();
     #endif
+    FLASH_TRANSACTION(offset,len);
     fseek(wad,offset,SEEK_SET);
     fread(dst,1,len,wad);
     #ifdef __chess__
     while (chess_cycle_count() < readtime+t0);
     #endif
 }
+
+// Requests at most this far apart are read in one transaction, reading through the gap.
+// With 100 cycles of overhead per transaction and 5 cycles per byte that pays off up to 20 bytes.
+#define WR_MAXGAP 20
+
+void WR_ReadV(const wr_request_t *reqs, int count) {
+    static uint8_t gap[WR_MAXGAP];
+    int first = 0;
+    while (first < count) {
+        // Find the run of requests that follow each other closely enough
+        int end = first+1;
+        while (end < count) {
+            int skip = reqs[end].offset - (reqs[end-1].offset+reqs[end-1].len);
+            if (skip < 0 || skip > WR_MAXGAP) break;
+            end++;
+        }
+        #ifdef __chess__
+        uint32_t readtime = 5*(reqs[end-1].offset+reqs[end-1].len-reqs[first].offset)+100;
+        uint32_t t0 = chess_cycle_count();
+        #endif
+        FLASH_TRANSACTION(reqs[first].offset,reqs[end-1].offset+reqs[end-1].len-reqs[first].offset);
+        fseek(wad,reqs[first].offset,SEEK_SET);
+        for (int i=first; i<end; i++) {
+            if (i > first) {
+                int skip = reqs[i].offset - (reqs[i-1].offset+reqs[i-1].len);
+                if (skip) fread(gap,1,skip,wad);
+            }
+            fread(reqs[i].dst,1,reqs[i].len,wad);
+        }
+        #ifdef __chess__
+        while (chess_cycle_count() < readtime+t0);
+        #endif
+        first = end;
+    }
+}
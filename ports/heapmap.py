@@ -0,0 +1,104 @@
+# This script renders the heap snapshots in heapmap.bin, written by a port built with
+# HEAPMAP_FRAMES=N, as a timeline.
+#
+#   python3 heapmap.py headless
+#
+# Prints one CSV row per snapshot with the free bytes, largest free block and fragmentation
+# (1 - largest / free) of both heaps and the bytes pinned in the cache. If PIL is there, it
+# also writes heapmap.png to the same directory: one column per snapshot with the heap from
+# the bottom of the cache (top) to the top of the objects (bottom), and below it the cache
+# fragmentation (red) and largest free extent (green) over time.
+import os
+import struct
+import sys
+
+HEADER = struct.Struct('<IIII')  # frame, blocks, cacheheapsize, objectheapsize
+BLOCK = struct.Struct('<IIIhH')  # th_blockinfo_t: offset, size, tag, lump, flags
+FREE_TAG = 0xffffffff
+PINNED = 1
+
+def read_snapshots(path):
+    """ Reads all snapshots from heapmap.bin as (frame, cachesize, objectsize, blocks). """
+    snapshots = []
+    with open(path, 'rb') as f:
+        while True:
+            data = f.read(HEADER.size)
+            if len(data) < HEADER.size:
+                break
+            frame, count, cachesize, objectsize = HEADER.unpack(data)
+            data = f.read(BLOCK.size * count)
+            blocks = [BLOCK.unpack_from(data, i * BLOCK.size) for i in range(count)]
+            snapshots.append((frame, cachesize, objectsize, blocks))
+    return snapshots
+
+def heap_stats(blocks, cachesize):
+    """ Free bytes and largest free block per heap, and bytes pinned in the cache. """
+    free = [0, 0]
+    largest = [0, 0]
+    pinned = 0
+    for offset, size, tag, lump, flags in blocks:
+        heap = 1 if offset >= cachesize else 0
+        if tag == FREE_TAG:
+            free[heap] += size
+            largest[heap] = max(largest[heap], size)
+        elif flags & PINNED:
+            pinned += size
+    return free, largest, pinned
+
+def fragmentation(free, largest):
+    return 1.0 - largest / free if free else 0.0
+
+def block_colour(tag, lump, flags):
+    if tag == FREE_TAG:
+        return (0, 0, 0)
+    if tag & 0x80000000:
+        return (60, 90, 200)    # Objects
+    if flags & PINNED:
+        return (230, 50, 50)    # Pinned lump
+    if lump >= 0:
+        return (60, 180, 60)    # Cached lump
+    return (220, 200, 40)       # Cache block the cache doesn't map
+
+def render(snapshots, stats, path, column=4, rows=400, graph=120):
+    from PIL import Image, ImageDraw
+    cachesize, objectsize = snapshots[0][1], snapshots[0][2]
+    heapsize = cachesize + objectsize
+    image = Image.new('RGB', (column * len(snapshots), rows + graph), (255, 255, 255))
+    draw = ImageDraw.Draw(image)
+    for x, (frame, _, _, blocks) in enumerate(snapshots):
+        for offset, size, tag, lump, flags in blocks:
+            top = offset * rows // heapsize
+            bottom = max(top, (offset + size) * rows // heapsize - 1)
+            draw.rectangle([x * column, top, (x + 1) * column - 1, bottom], fill=block_colour(tag, lump, flags))
+    draw.line([0, cachesize * rows // heapsize, image.width, cachesize * rows // heapsize], fill=(128, 128, 128))
+    # Cache fragmentation and largest free extent as a fraction of the cache heap
+    for x in range(1, len(stats)):
+        for value, colour in ((lambda s: s[3], (230, 50, 50)), (lambda s: s[2] / cachesize, (60, 180, 60))):
+            y0 = rows + graph - 1 - int(value(stats[x - 1]) * (graph - 1))
+            y1 = rows + graph - 1 - int(value(stats[x]) * (graph - 1))
+            draw.line([(x - 1) * column + column // 2, y0, x * column + column // 2, y1], fill=colour)
+    image.save(path)
+
+def main():
+    if len(sys.argv) != 2:
+        print("Usage: python3 heapmap.py <directory with heapmap.bin>")
+        sys.exit(1)
+    directory = sys.argv[1]
+    snapshots = read_snapshots(os.path.join(directory, 'heapmap.bin'))
+    if not snapshots:
+        print("No snapshots found")
+        sys.exit(1)
+    print("frame,cachefree,cachelargest,cachefrag,cachepinned,objectfree,objectlargest,objectfrag")
+    stats = []
+    for frame, cachesize, objectsize, blocks in snapshots:
+        free, largest, pinned = heap_stats(blocks, cachesize)
+        stats.append((frame, free[0], largest[0], fragmentation(free[0], largest[0])))
+        print("%d,%d,%d,%.4f,%d,%d,%d,%.4f" % (frame, free[0], largest[0], fragmentation(free[0], largest[0]),
+              pinned, free[1], largest[1], fragmentation(free[1], largest[1])))
+    try:
+        render(snapshots, stats, os.path.join(directory, 'heapmap.png'))
+    except ImportError:
+        print("PIL not found - no heapmap.png", file=sys.stderr)
+
+if __name__ == "__main__":
+    main()
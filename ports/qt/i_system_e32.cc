@@ -163,6 +163,46 @@ void I_CreateBackBuffer_e32()
 
 //**************************************************************************************
 
+#ifdef DUMP_SCREENBUFFER
+// Append the cache activity of the last finished frame to ncstats.csv
+static void I_DumpCacheStats()
+{
+    static FILE *csv = NULL;
+    if (!csv)
+    {
+        csv = fopen("ncstats.csv", "w");
+        if (!csv)
+            return;
+        fprintf(csv, "frame,hits,misses,evictions,defrags,defragbytes,bytesread\n");
+    }
+    nc_stats_t s;
+    if (NC_GetFrameStats(0, &s))
+        fprintf(csv, "%u,%u,%u,%u,%u,%u,%u\n", s.frame, s.hits, s.misses, s.evictions, s.defrags, s.defragbytes, s.bytesread);
+}
+
+// Write the lumps that missed in the cache, and how often, to nclumps.csv
+static void I_DumpLumpMisses()
+{
+    FILE *csv = fopen("nclumps.csv", "w");
+    if (!csv)
+        return;
+    fprintf(csv, "lump,name,misses\n");
+    for (int i = 0; i < WADLUMPS; i++)
+    {
+        int misses = NC_GetLumpMisses(i);
+        if (misses)
+        {
+            char name[9] = {0};
+            NC_GetNameForNum(i, name);
+            fprintf(csv, "%d,%s,%d\n", i, name, misses);
+        }
+    }
+    fclose(csv);
+}
+#endif
+
+//**************************************************************************************
+
 void I_FinishUpdate_e32(const uint8_t* srcBuffer, const uint8_t* pallete, const unsigned int width UNUSED, const unsigned int height UNUSED)
 {
     // BDPNOTE: This is where the screenbuffer is drawn
@@ -211,6 +251,7 @@ void I_FinishUpdate_e32(const uint8_t* srcBuffer, const uint8_t* pallete, const
     } else {
         printf("Failed to open screenbuffer dump file %s\n", filename);
     }
+    I_DumpCacheStats();
    #endif
 }
 
@@ -282,7 +323,9 @@ void I_Error (const char *error, ...)
 
 void I_Quit_e32()
 {
-
+   #ifdef DUMP_SCREENBUFFER
+    I_DumpLumpMisses();
+   #endif
 }
 
 //**************************************************************************************
@@ -8,7 +8,7 @@
 FILE *wad;
 
 void WR_Init(){
-    wad = fopen("gbadoom1.wad","rb");
+    wad = fopen(WR_WADFILE,"rb");
     if (!wad) {
         printf("Couldn't open WAD file\n");
         assert(false);exit(-1);
@@ -19,3 +19,34 @@ void WR_Read(uint8_t *dst, int offset, int len) {
     fseek(wad,offset,SEEK_SET);
     fread(dst,1,len,wad);
 }
+
+// Requests at most this far apart are read in one go, reading through the gap
+#define WR_MAXGAP 20
+
+void WR_ReadV(const wr_request_t *reqs, int count) {
+    static uint8_t gap[WR_MAXGAP];
+    int first = 0;
+    while (first < count) {
+        // Find the run of requests that follow each other closely enough
+        int end = first+1;
+        while (end < count) {
+            int skip = reqs[end].offset - (reqs[end-1].offset+reqs[end-1].len);
+            if (skip < 0 || skip > WR_MAXGAP) break;
+            end++;
+        }
+        fseek(wad,reqs[first].offset,SEEK_SET);
+        for (int i=first; i<end; i++) {
+            if (i > first) {
+                int skip = reqs[i].offset - (reqs[i-1].offset+reqs[i-1].len);
+                if (skip) fread(gap,1,skip,wad);
+            }
+            fread(reqs[i].dst,1,reqs[i].len,wad);
+        }
+        first = end;
+    }
+}
+
+uint32_t WR_FlashTime() {
+    // Reads are not timed
+    return 0;
+}